@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "batch.h"
+#include "config.h"
+#include "parallel.h"
+#include "sink.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <yaml-cpp/yaml.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+  // discards the output, writing to it only fills the caches of the Objects
+  class NullSink : public Sink
+  {
+  public:
+    void write(const char *, std::size_t ) {}
+  };
+}
+
+Batch::Batch(const Config& config, const std::vector<ObjectVariables>& objects) :
+  config(config),
+  objects(objects)
+{}
+
+Batch::Statistics Batch::run(const std::vector<Variables>& hosts, const std::string& output_dir, unsigned int n_threads) const
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  // after this the threads only read the cached output of the shared Objects
+  NullSink null_sink;
+  config.write(null_sink);
+
+  std::atomic<std::size_t> bytes(0);
+
+  parallel_for(hosts.size(), n_threads, [&](std::size_t i) {
+    const Variables& variables = hosts[i];
+
+    auto host = variables.find("host");
+    if (host == variables.end())
+    {
+      throw std::runtime_error("host " + std::to_string(i + 1) + " has no host variable");
+    }
+
+    if (host->second.empty() || host->second == "." || host->second == ".." || host->second.find('/') != std::string::npos)
+    {
+      throw std::runtime_error("invalid host: " + host->second);
+    }
+
+    // the copies are not from the arena and not counted in the configuration, so the threads share nothing
+    std::vector< std::shared_ptr<Object> > copies;
+    Substitutions substitutions;
+
+    for (const ObjectVariables& object : objects)
+    {
+      std::shared_ptr<Object> copy = object.object->clone(nullptr);
+      copy->get_generation().set_parent(nullptr);
+
+      for (const ObjectVariables::Value& value : object.values)
+      {
+        Option& option = get_option(*copy, value.path);
+
+        const std::string substituted = substitute(value.value, variables);
+        if (!is_valid_value(option, substituted))
+        {
+          throw std::runtime_error("host " + host->second + ": invalid value of " + copy->get_name() + " " +
+                                   option.get_name() + ": " + substituted);
+        }
+
+        option.set_current(substituted);
+      }
+
+      substitutions.emplace(object.object, copy.get());
+      copies.push_back(std::move(copy));
+    }
+
+    const std::string file_name = get_file_name(output_dir, host->second);
+    const QString dir_name = QFileInfo(QString::fromStdString(file_name)).path();
+    if (!QDir().mkpath(dir_name))
+    {
+      throw std::runtime_error("can't create directory: " + dir_name.toStdString());
+    }
+
+    std::ofstream file(file_name, std::ios::binary);
+    {
+      StreamSink sink(file);
+      config.write(sink, 1, &substitutions);
+    }
+
+    if (!file)
+    {
+      throw std::runtime_error("write failed: " + file_name);
+    }
+
+    bytes += file.tellp();
+  });
+
+  Statistics statistics;
+  statistics.hosts = hosts.size();
+  statistics.copied_objects = hosts.size() * objects.size();
+  statistics.bytes = bytes;
+  statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  return statistics;
+}
+
+std::string Batch::get_file_name(const std::string& output_dir, const std::string& host)
+{
+  const QString dir_name = QDir(QString::fromStdString(output_dir)).filePath(QString::fromStdString(host));
+
+  return QDir(dir_name).filePath("syslog-ng.conf").toStdString();
+}
+
+std::vector<Variables> Batch::load_hosts(const std::string& file_name)
+{
+  const YAML::Node yaml_hosts = YAML::LoadFile(file_name);
+
+  if (!yaml_hosts.IsSequence())
+  {
+    throw std::runtime_error("the hosts are not a list");
+  }
+
+  std::vector<Variables> hosts;
+  hosts.reserve(yaml_hosts.size());
+
+  // the line of each host, the hosts are written to files named after them in parallel
+  std::unordered_map<std::string, int> lines;
+
+  for (const YAML::Node& yaml_host : yaml_hosts)
+  {
+    Variables variables;
+
+    for (YAML::const_iterator it = yaml_host.begin(); it != yaml_host.end(); ++it)
+    {
+      variables.emplace(it->first.as<std::string>(), it->second.as<std::string>());
+    }
+
+    auto host = variables.find("host");
+    if (host != variables.end())
+    {
+      const int line = yaml_host["host"].Mark().line + 1;
+      auto inserted = lines.emplace(host->second, line);
+      if (!inserted.second)
+      {
+        throw std::runtime_error(file_name + ":" + std::to_string(line) + ": duplicate host: " + host->second +
+                                 ", first on line " + std::to_string(inserted.first->second));
+      }
+    }
+
+    hosts.push_back(std::move(variables));
+  }
+
+  return hosts;
+}
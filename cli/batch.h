@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "description.h"
+
+#include <string>
+#include <vector>
+
+class Config;
+
+/*
+ * Renders the same configuration for many hosts, with the {{name}} variables of the option values
+ * replaced by the values of each host, see Description::get_variables and substitute.
+ * The hosts are rendered in parallel. The configuration is shared, only the Objects with variables are copied for each host.
+ */
+class Batch
+{
+  const Config& config;
+  const std::vector<ObjectVariables>& objects;
+
+public:
+  struct Statistics
+  {
+    std::size_t hosts = 0;
+    std::size_t copied_objects = 0;  // Objects copied for the variables, in total
+    std::size_t bytes = 0;           // bytes written, in total
+    double seconds = 0;
+  };
+
+  /*
+   * @objects: the Objects of @config with variables.
+   */
+  Batch(const Config& config, const std::vector<ObjectVariables>& objects);
+
+  /*
+   * Writes @output_dir/HOST/syslog-ng.conf for every host, where HOST is the "host" variable.
+   * @n_threads: number of hosts rendered at the same time, 0 means one per core.
+   * The configuration must not be edited meanwhile.
+   * Throws std::runtime_error for a missing host variable, a substituted value that is not valid for its option,
+   * or a file that can't be written.
+   */
+  Statistics run(const std::vector<Variables>& hosts, const std::string& output_dir, unsigned int n_threads) const;
+
+  /*
+   * @return: returns the name of the file written for @host into @output_dir, see run.
+   */
+  static std::string get_file_name(const std::string& output_dir, const std::string& host);
+
+  /*
+   * @return: returns the variables of each host from a yaml or json list of name: value maps.
+   * Throws std::runtime_error with the line of the second one if two hosts have the same host variable.
+   */
+  static std::vector<Variables> load_hosts(const std::string& file_name);
+};
+
+#endif  // BATCH_H
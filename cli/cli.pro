@@ -0,0 +1,18 @@
+TEMPLATE = app
+CONFIG += c++17 console
+CONFIG -= app_bundle
+TARGET = syslog-ng-config-cli
+DESTDIR = ../
+OBJECTS_DIR = ../build/cli
+# no QtGui or QtWidgets
+QT = core
+include(../core/core.pri)
+
+SOURCES += \
+    batch.cpp \
+    description.cpp \
+    main.cpp
+
+HEADERS += \
+    batch.h \
+    description.h
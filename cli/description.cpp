@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "description.h"
+#include "config.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+Description::Description(Config& config) :
+  config(config)
+{}
+
+void Description::load_file(const std::string& file_name)
+{
+  load(YAML::LoadFile(file_name));
+}
+
+void Description::load(const std::string& text)
+{
+  load(YAML::Load(text));
+}
+
+const std::vector<ObjectVariables>& Description::get_variables() const
+{
+  return variables;
+}
+
+void Description::load(const YAML::Node& description)
+{
+  if (!description.IsMap())
+  {
+    throw std::runtime_error("the description is not a map");
+  }
+
+  if (const YAML::Node& options = description["options"])
+  {
+    set_options(config.get_global_options(), options);
+  }
+
+  for (const YAML::Node& yaml_statement : description["statements"])
+  {
+    add_object_statement(yaml_statement);
+  }
+
+  for (const YAML::Node& yaml_log : description["logs"])
+  {
+    add_log_statement(yaml_log);
+  }
+}
+
+void Description::add_object_statement(const YAML::Node& yaml_statement)
+{
+  const std::string id = yaml_statement["id"].as<std::string>();
+  const std::string type = yaml_statement["type"].as<std::string>();
+
+  if (!ids.emplace(id, object_statements.size()).second)
+  {
+    throw std::runtime_error("duplicate statement id: " + id);
+  }
+
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(id);
+
+  int position = 0;
+  for (const YAML::Node& yaml_object : yaml_statement["objects"])
+  {
+    object_statement->add_object(create_object(yaml_object, type), position++);
+  }
+
+  object_statements.push_back(std::move(object_statement));
+}
+
+void Description::add_log_statement(const YAML::Node& yaml_log)
+{
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+
+  int position = 0;
+  for (const YAML::Node& yaml_id : yaml_log["statements"])
+  {
+    const std::string id = yaml_id.as<std::string>();
+
+    auto it = ids.find(id);
+    if (it == ids.end())
+    {
+      throw std::runtime_error("unknown statement id in log: " + id);
+    }
+
+    log_statement->add_object_statement(object_statements[it->second], position++);
+  }
+
+  if (const YAML::Node& options = yaml_log["options"])
+  {
+    set_options(log_statement->get_options(), options);
+  }
+
+  log_statements.push_back(std::move(log_statement));
+}
+
+std::shared_ptr<Object> Description::create_object(const YAML::Node& yaml_object, const std::string& type)
+{
+  const std::string name = yaml_object["name"].as<std::string>();
+
+  std::shared_ptr<Object> object = config.create_object(name, type);
+
+  if (const YAML::Node& options = yaml_object["options"])
+  {
+    set_options(*object, options);
+  }
+
+  if (type == "filter")
+  {
+    Filter& filter = static_cast<Filter&>(*object);
+
+    if (const YAML::Node& invert = yaml_object["invert"])
+    {
+      filter.set_invert(invert.as<bool>());
+    }
+
+    if (const YAML::Node& next = yaml_object["next"])
+    {
+      filter.set_next(next.as<std::string>());
+    }
+  }
+
+  return object;
+}
+
+void Description::set_options(Object& object, const YAML::Node& yaml_options)
+{
+  std::vector<std::size_t> path;
+  set_options(object, yaml_options, object, path);
+}
+
+void Description::set_options(Object& object, const YAML::Node& yaml_options, const Object& root, std::vector<std::size_t>& path)
+{
+  if (!yaml_options.IsMap())
+  {
+    throw std::runtime_error("the options of " + object.get_name() + " are not a map");
+  }
+
+  for (YAML::const_iterator it = yaml_options.begin(); it != yaml_options.end(); ++it)
+  {
+    const std::string name = it->first.as<std::string>();
+
+    OptionVector& options = object.get_options();
+    auto option = std::find_if(options.begin(), options.end(),
+                               [&name](const Option& option)->bool {
+                                 return option.get_name() == name;
+                               });
+
+    if (option == options.end())
+    {
+      throw std::runtime_error("unknown option of " + object.get_name() + ": " + name);
+    }
+
+    path.push_back(option - options.begin());
+
+    if (option->get_type() == OptionType::OPTIONS)
+    {
+      set_options(option->get_options(), it->second, root, path);
+    }
+    else
+    {
+      set_value(*option, it->second.as<std::string>(), root, path);
+    }
+
+    path.pop_back();
+  }
+}
+
+void Description::set_value(Option& option, const std::string& value, const Object& root, const std::vector<std::size_t>& path)
+{
+  std::size_t n_variables = 0;
+  const std::string unescaped = substitute(value, Variables(), &n_variables);
+
+  if (n_variables != 0)
+  {
+    if (variables.empty() || variables.back().object != &root)
+    {
+      variables.push_back(ObjectVariables{&root, {}});
+    }
+    variables.back().values.push_back(ObjectVariables::Value{path, value});
+
+    // the other types can't hold the variables, only their substituted values
+    if (option.get_type() == OptionType::STRING || option.get_type() == OptionType::SET)
+    {
+      option.set_current(value);
+    }
+    return;
+  }
+
+  if (!is_valid_value(option, unescaped))
+  {
+    throw std::runtime_error("invalid value of " + root.get_name() + " " + option.get_name() + ": " + unescaped);
+  }
+
+  option.set_current(unescaped);
+}
+
+/*
+ * @return: returns the length of the {{name}} variable at @position of @text, 0 if there is none.
+ */
+static std::size_t variable_length(const std::string& text, std::size_t position)
+{
+  if (text.compare(position, 2, "{{") != 0)
+  {
+    return 0;
+  }
+
+  const std::size_t end = text.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-.", position + 2);
+  if (end == position + 2 || end == std::string::npos || text.compare(end, 2, "}}") != 0)
+  {
+    return 0;
+  }
+
+  return end + 2 - position;
+}
+
+Option& get_option(Object& root, const std::vector<std::size_t>& path)
+{
+  return const_cast<Option&>(get_option(static_cast<const Object&>(root), path));
+}
+
+const Option& get_option(const Object& root, const std::vector<std::size_t>& path)
+{
+  const Option* option = &root.get_options()[path[0]];
+  for (std::size_t i = 1; i < path.size(); i++)
+  {
+    option = &option->get_options().get_options()[path[i]];
+  }
+
+  return *option;
+}
+
+std::string substitute(const std::string& text, const Variables& variables, std::size_t* n_variables)
+{
+  std::string result;
+  result.reserve(text.size());
+
+  if (n_variables)
+  {
+    *n_variables = 0;
+  }
+
+  std::size_t position = 0;
+  for (std::size_t begin = text.find("{{"); begin != std::string::npos; begin = text.find("{{", position))
+  {
+    result.append(text, position, begin - position);
+
+    if (text.compare(begin, 4, "{{{{") == 0)
+    {
+      result += "{{";
+      position = begin + 4;
+      continue;
+    }
+
+    const std::size_t length = variable_length(text, begin);
+    if (length == 0)
+    {
+      result += "{{";
+      position = begin + 2;
+      continue;
+    }
+
+    if (n_variables)
+    {
+      (*n_variables)++;
+    }
+
+    auto variable = variables.find(text.substr(begin + 2, length - 4));
+    if (variable == variables.end())
+    {
+      result.append(text, begin, length);
+    }
+    else
+    {
+      result += variable->second;
+    }
+
+    position = begin + length;
+  }
+
+  result.append(text, position, std::string::npos);
+
+  return result;
+}
+
+bool is_valid_value(const Option& option, const std::string& value)
+{
+  switch (option.get_type())
+  {
+    case OptionType::NUMBER:
+    {
+      const std::size_t digits = !value.empty() && value[0] == '-' ? 1 : 0;
+      if (value.size() == digits || value.find_first_not_of("0123456789", digits) != std::string::npos)
+      {
+        return false;
+      }
+
+      try
+      {
+        std::stoi(value);
+      }
+      catch (const std::out_of_range&)
+      {
+        return false;
+      }
+
+      return true;
+    }
+    case OptionType::LIST:
+    {
+      const std::vector<Atom>& values = option.get_schema().values;
+      return std::any_of(values.begin(), values.end(), [&value](const Atom& atom) { return atom.str() == value; });
+    }
+    default:
+      return true;
+  }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef DESCRIPTION_H
+#define DESCRIPTION_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace YAML {
+  class Node;
+}
+class Config;
+class Object;
+class Options;
+class Option;
+class ObjectStatement;
+class LogStatement;
+
+// variable name -> value
+typedef std::unordered_map<std::string, std::string> Variables;
+
+/*
+ * Option values with {{name}} variables in an Object of the description, see Batch.
+ * The syntax doesn't clash with the ${MACRO} templates of syslog-ng, {{{{ stands for a literal {{.
+ */
+struct ObjectVariables
+{
+  struct Value
+  {
+    std::vector<std::size_t> path;  // index of the option, then of the nested options
+    std::string value;              // with the variables
+  };
+
+  const Object* object;
+  std::vector<Value> values;
+};
+
+/*
+ * @return: returns the option of @root at @path, see ObjectVariables::Value.
+ */
+Option& get_option(Object& root, const std::vector<std::size_t>& path);
+const Option& get_option(const Object& root, const std::vector<std::size_t>& path);
+
+/*
+ * @return: returns @text with every {{name}} replaced by the value of name in @variables,
+ * the variables not in @variables are left as they are, {{{{ is replaced by {{.
+ * @n_variables: set to the number of {{name}} variables in @text, known or not, if not nullptr.
+ */
+std::string substitute(const std::string& text, const Variables& variables, std::size_t* n_variables = nullptr);
+
+/*
+ * @return: returns false if @value can't be the value of @option:
+ * a NUMBER option takes an integer, a LIST option one of its values.
+ * set_current would throw or silently unset the option for these.
+ */
+bool is_valid_value(const Option& option, const std::string& value);
+
+/*
+ * Builds a configuration from a declarative yaml or json description, see example.yml.
+ * The statements are held by the Description, they are removed from the Config when it is destroyed.
+ * Throws std::runtime_error for an invalid description,
+ * and std::out_of_range for an Object that is not a default Object of the Config.
+ */
+class Description
+{
+  Config& config;
+
+  std::vector< std::shared_ptr<ObjectStatement> > object_statements;
+  std::vector< std::shared_ptr<LogStatement> > log_statements;
+
+  // ID -> index in object_statements, for the log statements
+  std::unordered_map<std::string, std::size_t> ids;
+
+  std::vector<ObjectVariables> variables;
+
+public:
+  explicit Description(Config& config);
+
+  void load_file(const std::string& file_name);
+  void load(const std::string& text);
+
+  /*
+   * @return: returns the Objects with variables in their option values.
+   * Only string values are set to the text with the variables, the others keep their default value.
+   */
+  const std::vector<ObjectVariables>& get_variables() const;
+
+private:
+  void load(const YAML::Node& description);
+
+  void add_object_statement(const YAML::Node& yaml_statement);
+  void add_log_statement(const YAML::Node& yaml_log);
+
+  std::shared_ptr<Object> create_object(const YAML::Node& yaml_object, const std::string& type);
+
+  /*
+   * Sets the options of @object from the name: value pairs of @yaml_options,
+   * a nested map sets the Options of an OptionType::OPTIONS option.
+   */
+  void set_options(Object& object, const YAML::Node& yaml_options);
+
+  // @root: the Object holding @object, @path: the position of @object in it
+  void set_options(Object& object, const YAML::Node& yaml_options, const Object& root, std::vector<std::size_t>& path);
+
+  /*
+   * Sets @option to @value, or records it in @variables if it has variables.
+   * Throws std::runtime_error if @value is not valid for @option, see is_valid_value.
+   */
+  void set_value(Option& option, const std::string& value, const Object& root, const std::vector<std::size_t>& path);
+};
+
+#endif  // DESCRIPTION_H
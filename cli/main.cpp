@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Generates a syslog-ng configuration from a description, without the GUI.
+ *
+ * usage: syslog-ng-config-cli [-o OUTPUT] [-j THREADS] [-d OBJECTS_DIR] [-b HOSTS]
+ *                             [-c REPORT] [-p PROCESSES] [-s SYSLOG_NG] [-l] DESCRIPTION
+ */
+
+#include "batch.h"
+#include "description.h"
+#include "batchvalidator.h"
+#include "linter.h"
+#include "config.h"
+#include "sink.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+/*
+ * Checks @file_names with syslog-ng, see BatchValidator.
+ * @return: returns false if any of them is not valid.
+ */
+static bool check_files(const std::vector<std::string>& file_names, const std::string& report_file,
+                        unsigned int n_processes, const std::string& syslog_ng)
+{
+  BatchValidator batch_validator;
+  batch_validator.set_processes(n_processes);
+  if (!syslog_ng.empty())
+  {
+    batch_validator.set_program(QString::fromStdString(syslog_ng), { "-s", "-f" });
+  }
+
+  std::ofstream file;
+  if (report_file != "-")
+  {
+    file.open(report_file, std::ios::binary);
+  }
+
+  BatchValidator::Statistics statistics;
+  {
+    StreamSink sink(report_file == "-" ? std::cout : file);
+    statistics = batch_validator.run(file_names, sink);
+  }
+
+  if (report_file != "-" && !file)
+  {
+    throw std::runtime_error(report_file + ": write failed");
+  }
+
+  std::cerr << statistics.configs << " configurations, " << statistics.runs << " checked, "
+            << statistics.valid << " valid, " << statistics.invalid << " invalid, " << statistics.failed << " failed in "
+            << statistics.seconds << " s (latency median " << statistics.median_milliseconds << " ms, 95% "
+            << statistics.p95_milliseconds << " ms, max " << statistics.max_milliseconds << " ms)" << std::endl;
+
+  return statistics.valid == statistics.configs;
+}
+
+static int usage(const char* name)
+{
+  std::cerr << "usage: " << name << " [-o OUTPUT] [-j THREADS] [-d OBJECTS_DIR] [-b HOSTS]" << std::endl
+            << "       " << std::string(std::strlen(name), ' ') << " [-c REPORT] [-p PROCESSES] [-s SYSLOG_NG] [-l] DESCRIPTION" << std::endl
+            << "  -o OUTPUT       write the configuration to OUTPUT instead of the standard output" << std::endl
+            << "  -j THREADS      number of threads rendering the configuration, 0 means one per core, 1 by default" << std::endl
+            << "  -d OBJECTS_DIR  read the default Objects from the yaml files of OBJECTS_DIR" << std::endl
+            << "  -b HOSTS        write OUTPUT/HOST/syslog-ng.conf for each host of the HOSTS list," << std::endl
+            << "                  with the {{name}} variables of the description replaced by their values" << std::endl
+            << "  -c REPORT       check the written configurations with syslog-ng -s, the result of each one" << std::endl
+            << "                  is written to the REPORT JSON lines file as soon as it's known, - for the standard output" << std::endl
+            << "  -p PROCESSES    number of syslog-ng processes checking at the same time, 0 means one per core" << std::endl
+            << "  -s SYSLOG_NG    the syslog-ng executable used by -c" << std::endl
+            << "  -l              warn about unused statements, empty log paths, filters that never match," << std::endl
+            << "                  files written by multiple destinations and log paths shadowed by final ones" << std::endl;
+
+  return 1;
+}
+
+/*
+ * Reads the number of threads or processes from @value.
+ * @return: returns false if @value is not a non-negative integer.
+ */
+static bool parse_count(const std::string& value, unsigned int& count)
+{
+  if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+  {
+    return false;
+  }
+
+  try
+  {
+    const unsigned long number = std::stoul(value);
+    if (number > std::numeric_limits<unsigned int>::max())
+    {
+      return false;
+    }
+
+    count = number;
+  }
+  catch (const std::out_of_range&)
+  {
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  std::string output;
+  std::string objects_dir;
+  std::string hosts_file;
+  std::string report_file;
+  std::string syslog_ng;
+  unsigned int n_threads = 1;
+  unsigned int n_processes = 0;
+  bool lint_description = false;
+  std::string description_file;
+
+  for (int i = 1; i < argc; i++)
+  {
+    const std::string arg = argv[i];
+
+    if ((arg == "-o" || arg == "-j" || arg == "-d" || arg == "-b" || arg == "-c" || arg == "-p" || arg == "-s") && i + 1 < argc)
+    {
+      const std::string value = argv[++i];
+
+      if (arg == "-o")
+      {
+        output = value;
+      }
+      else if (arg == "-j")
+      {
+        if (!parse_count(value, n_threads))
+        {
+          return usage(argv[0]);
+        }
+      }
+      else if (arg == "-d")
+      {
+        objects_dir = value;
+      }
+      else if (arg == "-b")
+      {
+        hosts_file = value;
+      }
+      else if (arg == "-c")
+      {
+        report_file = value;
+      }
+      else if (arg == "-p")
+      {
+        if (!parse_count(value, n_processes))
+        {
+          return usage(argv[0]);
+        }
+      }
+      else
+      {
+        syslog_ng = value;
+      }
+    }
+    else if (arg == "-l")
+    {
+      lint_description = true;
+    }
+    else if (arg[0] != '-' && description_file.empty())
+    {
+      description_file = arg;
+    }
+    else
+    {
+      return usage(argv[0]);
+    }
+  }
+
+  if (description_file.empty() || ((!hosts_file.empty() || !report_file.empty()) && output.empty()))
+  {
+    return usage(argv[0]);
+  }
+
+  try
+  {
+    std::unique_ptr<Config> config = objects_dir.empty() ? std::make_unique<Config>() : std::make_unique<Config>(objects_dir);
+
+    Description description(*config);
+    description.load_file(description_file);
+
+    // the variables are replaced only with -b, a NUMBER or LIST option would silently keep its default
+    if (hosts_file.empty())
+    {
+      for (const ObjectVariables& object : description.get_variables())
+      {
+        for (const ObjectVariables::Value& value : object.values)
+        {
+          const Option& option = get_option(*object.object, value.path);
+          if (option.get_type() == OptionType::NUMBER || option.get_type() == OptionType::LIST)
+          {
+            throw std::runtime_error("variables need -b HOSTS: " + object.object->get_name() + " " + option.get_name() + ": " + value.value);
+          }
+        }
+      }
+    }
+
+    // only warnings, the configuration is written anyway
+    if (lint_description)
+    {
+      for (const LintDiagnostic& diagnostic : lint(*config))
+      {
+        std::cerr << description_file << ": " << diagnostic.location << ": " << diagnostic.message << std::endl;
+      }
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    // the files to check with -c
+    std::vector<std::string> file_names;
+
+    if (!hosts_file.empty())
+    {
+      const std::vector<Variables> hosts = Batch::load_hosts(hosts_file);
+
+      const Batch::Statistics statistics = Batch(*config, description.get_variables()).run(hosts, output, n_threads);
+
+      std::cerr << statistics.hosts << " hosts, " << statistics.copied_objects << " copied objects, "
+                << statistics.bytes << " bytes in " << statistics.seconds << " s ("
+                << statistics.hosts / statistics.seconds << " hosts/s, "
+                << statistics.bytes / statistics.seconds / (1024 * 1024) << " MiB/s)" << std::endl;
+
+      for (const Variables& host : hosts)
+      {
+        file_names.push_back(Batch::get_file_name(output, host.at("host")));
+      }
+    }
+    else if (output.empty())
+    {
+      StreamSink sink(std::cout);
+      config->write(sink, n_threads);
+    }
+    else
+    {
+      std::ofstream file(output, std::ios::binary);
+      {
+        StreamSink sink(file);
+        config->write(sink, n_threads);
+      }
+
+      if (!file)
+      {
+        std::cerr << output << ": write failed" << std::endl;
+        return 1;
+      }
+
+      file_names.push_back(output);
+    }
+
+    if (!report_file.empty() && !check_files(file_names, report_file, n_processes, syslog_ng))
+    {
+      return 1;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << description_file << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "arena.h"
+
+#include <algorithm>
+
+Arena::Arena() :
+  pool(&monotonic),
+  largest_pooled_block(pool.options().largest_required_pool_block)
+{}
+
+const Arena::Statistics& Arena::get_statistics() const
+{
+  return statistics;
+}
+
+bool Arena::reset()
+{
+  if (pooled_allocations != 0)
+  {
+    return false;
+  }
+
+  pool.release();
+  monotonic.release();
+
+  return true;
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  void* pointer = nullptr;
+  if (bytes > largest_pooled_block)
+  {
+    pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  else
+  {
+    pointer = pool.allocate(bytes, alignment);
+    pooled_allocations++;
+  }
+
+  statistics.allocations++;
+  statistics.live_allocations++;
+  statistics.bytes += bytes;
+  statistics.peak_bytes = std::max(statistics.peak_bytes, statistics.bytes);
+
+  return pointer;
+}
+
+void Arena::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+{
+  if (bytes > largest_pooled_block)
+  {
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+  else
+  {
+    pool.deallocate(pointer, bytes, alignment);
+    pooled_allocations--;
+  }
+
+  statistics.live_allocations--;
+  statistics.bytes -= bytes;
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+  return this == &other;
+}
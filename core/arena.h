@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <memory>
+#include <memory_resource>
+
+/*
+ * Memory of a configuration: a pool of fixed size blocks on top of a monotonic buffer.
+ * Freed blocks are reused by the pool, and reset() releases all of them at once, instead of one allocation at a time.
+ * Blocks larger than the largest block of the pool, like the buffers of growing containers,
+ * are allocated and freed one by one, so the buffer a container outgrew is given back right away.
+ * Not thread-safe, a configuration is only edited by a single thread.
+ */
+class Arena : public std::pmr::memory_resource
+{
+public:
+  struct Statistics
+  {
+    std::size_t allocations = 0;       // total number of allocations
+    std::size_t live_allocations = 0;  // allocations not yet freed
+    std::size_t bytes = 0;             // bytes in use
+    std::size_t peak_bytes = 0;        // highest number of bytes in use at the same time
+  };
+
+private:
+  std::pmr::monotonic_buffer_resource monotonic;
+  std::pmr::unsynchronized_pool_resource pool;
+  std::size_t largest_pooled_block;
+  std::size_t pooled_allocations = 0;  // blocks of the pool not yet freed
+  Statistics statistics;
+
+public:
+  Arena();
+
+  const Statistics& get_statistics() const;
+
+  /*
+   * Releases the memory of the pool at once, the blocks freed since the last reset are not kept for reuse.
+   * @return: returns false if a block of the pool is still in use, then nothing is released.
+   */
+  bool reset();
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment);
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment);
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept;
+
+  // non copyable
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+};
+
+/*
+ * Allocator for the containers and shared_ptrs of the model types.
+ * Every copy keeps the Arena alive, so it can outlive the Config owning it,
+ * e.g. Objects held by icons are freed after Config at exit.
+ * Without an Arena it falls back to the global operator new.
+ */
+template<typename T>
+class ArenaAllocator
+{
+  std::shared_ptr<Arena> arena;
+
+public:
+  typedef T value_type;
+
+  ArenaAllocator() noexcept {}
+
+  explicit ArenaAllocator(std::shared_ptr<Arena> arena) noexcept :
+    arena(std::move(arena))
+  {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+    arena(other.get_arena())
+  {}
+
+  const std::shared_ptr<Arena>& get_arena() const noexcept
+  {
+    return arena;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    if (arena)
+    {
+      return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t n) noexcept
+  {
+    if (arena)
+    {
+      arena->deallocate(pointer, n * sizeof(T), alignof(T));
+      return;
+    }
+
+    ::operator delete(pointer);
+  }
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+  return a.get_arena() == b.get_arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+  return !(a == b);
+}
+
+#endif  // ARENA_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "atom.h"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace
+{
+  // the nodes of an unordered_set are never moved, so the pointers to the strings stay valid
+  std::unordered_set<std::string>& table()
+  {
+    static std::unordered_set<std::string> strings;
+    return strings;
+  }
+
+  std::mutex& table_mutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+}
+
+Atom::Atom(const std::string& string)
+{
+  if (string.empty())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(table_mutex());
+  this->string = &*table().insert(string).first;
+}
+
+Atom::Atom(const char* string) :
+  Atom(std::string(string))
+{}
+
+const std::string& Atom::str() const
+{
+  static const std::string empty_string;
+  return string ? *string : empty_string;
+}
+
+bool Atom::find(const std::string& string, Atom& atom)
+{
+  if (string.empty())
+  {
+    atom = Atom();
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(table_mutex());
+
+  auto it = table().find(string);
+  if (it == table().end())
+  {
+    return false;
+  }
+
+  atom.string = &*it;
+  return true;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef ATOM_H
+#define ATOM_H
+
+#include <string>
+#include <functional>
+
+/*
+ * Handle of an interned string.
+ * Every distinct string is stored once in a global table, equal strings get the same Atom,
+ * so Atoms are compared and hashed by pointer instead of character by character.
+ * The table is never cleared, only intern names, types and values from the schemas.
+ */
+class Atom
+{
+  const std::string* string = nullptr;  // nullptr is the empty string
+
+public:
+  Atom() {}
+  explicit Atom(const std::string& string);
+  explicit Atom(const char* string);
+
+  const std::string& str() const;
+  bool empty() const { return !string; }
+
+  bool operator==(const Atom& other) const { return string == other.string; }
+  bool operator!=(const Atom& other) const { return string != other.string; }
+
+  /*
+   * Look up @string without interning it.
+   * @return: false if @string was never interned, so it can't equal any Atom.
+   */
+  static bool find(const std::string& string, Atom& atom);
+
+  friend struct std::hash<Atom>;
+};
+
+namespace std
+{
+  template<>
+  struct hash<Atom>
+  {
+    std::size_t operator()(const Atom& atom) const
+    {
+      return std::hash<const std::string*>()(atom.string);
+    }
+  };
+}
+
+#endif  // ATOM_H
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "batchvalidator.h"
+#include "validator.h"
+#include "sink.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  class BatchJob : public QRunnable
+  {
+    const std::function<void()> function;
+
+  public:
+    explicit BatchJob(const std::function<void()>& function) :
+      function(function)
+    {}
+
+    void run()
+    {
+      function();
+    }
+  };
+
+  // the files with the same contents, only the first one is checked
+  struct Duplicates
+  {
+    std::string file_name;
+    bool done = false;
+    ValidationResult result;
+    std::vector<std::string> waiting;  // found while the first one was being checked
+  };
+
+  const char* get_status_name(ValidationStatus status)
+  {
+    switch (status)
+    {
+      case ValidationStatus::VALID: return "valid";
+      case ValidationStatus::INVALID: return "invalid";
+      case ValidationStatus::TIMED_OUT: return "timed_out";
+      case ValidationStatus::NOT_STARTED: return "not_started";
+      case ValidationStatus::CANCELED: return "canceled";
+    }
+
+    return "";
+  }
+
+  void write_json_string(Sink& sink, const std::string& string)
+  {
+    static const char hex_digits[] = "0123456789abcdef";
+
+    sink << '"';
+
+    for (const char c : string)
+    {
+      switch (c)
+      {
+        case '"': sink << "\\\""; break;
+        case '\\': sink << "\\\\"; break;
+        case '\n': sink << "\\n"; break;
+        case '\t': sink << "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20)
+          {
+            sink << "\\u00" << hex_digits[c >> 4] << hex_digits[c & 0xf];
+          }
+          else
+          {
+            sink << c;
+          }
+      }
+    }
+
+    sink << '"';
+  }
+
+  /*
+   * Writes the report line of @file_name, see BatchValidator::run.
+   * @duplicate_of: the file that was checked in place of @file_name, nullptr if it was @file_name itself.
+   */
+  void write_line(Sink& sink, const std::string& file_name, const std::string& hash,
+                  const ValidationResult& result, const std::string* duplicate_of)
+  {
+    sink << "{\"file\":";
+    write_json_string(sink, file_name);
+    sink << ",\"status\":\"" << get_status_name(result.status) << "\",\"milliseconds\":" << std::to_string(result.milliseconds);
+    sink << ",\"sha1\":\"" << hash << '"';
+
+    if (duplicate_of)
+    {
+      sink << ",\"duplicate_of\":";
+      write_json_string(sink, *duplicate_of);
+    }
+
+    sink << ",\"message\":";
+    write_json_string(sink, result.message);
+    sink << "}\n";
+  }
+}
+
+
+void BatchValidator::set_program(const QString& program, const QStringList& arguments)
+{
+  this->program = program;
+  this->arguments = arguments;
+}
+
+void BatchValidator::set_processes(unsigned int n_processes)
+{
+  this->n_processes = n_processes;
+}
+
+void BatchValidator::set_timeout(int milliseconds)
+{
+  timeout = milliseconds;
+}
+
+BatchValidator::Statistics BatchValidator::run(const std::vector<std::string>& file_names, Sink& report) const
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  Statistics statistics;
+  statistics.configs = file_names.size();
+  std::vector<qint64> latencies;
+
+  // guards everything below, the report and the statistics too
+  std::mutex mutex;
+  std::unordered_map<std::string, Duplicates> checked;
+
+  // called with @mutex locked
+  const auto add_result = [&](const std::string& file_name, const std::string& hash,
+                              const ValidationResult& result, const std::string* duplicate_of) {
+    switch (result.status)
+    {
+      case ValidationStatus::VALID: statistics.valid++; break;
+      case ValidationStatus::INVALID: statistics.invalid++; break;
+      default: statistics.failed++;
+    }
+
+    write_line(report, file_name, hash, result, duplicate_of);
+    report.flush();
+  };
+
+  QThreadPool pool;
+  if (n_processes)
+  {
+    pool.setMaxThreadCount(n_processes);
+  }
+
+  for (const std::string& file_name : file_names)
+  {
+    pool.start(new BatchJob([&, file_name]() {
+      QFile file(QString::fromStdString(file_name));
+      if (!file.open(QIODevice::ReadOnly))
+      {
+        ValidationResult result;
+        result.message = "can't read the file";
+
+        std::lock_guard<std::mutex> lock(mutex);
+        add_result(file_name, std::string(), result, nullptr);
+        return;
+      }
+
+      const std::string hash = QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1).toHex().toStdString();
+      file.close();
+
+      Duplicates* duplicates = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // the elements of an unordered_map stay in place, the pointer is valid until the end
+        auto inserted = checked.emplace(hash, Duplicates());
+        duplicates = &inserted.first->second;
+
+        if (!inserted.second)
+        {
+          if (duplicates->done)
+          {
+            add_result(file_name, hash, duplicates->result, &duplicates->file_name);
+          }
+          else
+          {
+            duplicates->waiting.push_back(file_name);
+          }
+          return;
+        }
+
+        duplicates->file_name = file_name;
+      }
+
+      const ValidationResult result = run_validator(program, arguments, QString::fromStdString(file_name), timeout);
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      duplicates->done = true;
+      duplicates->result = result;
+
+      if (result.status != ValidationStatus::NOT_STARTED)
+      {
+        statistics.runs++;
+        latencies.push_back(result.milliseconds);
+      }
+
+      add_result(file_name, hash, result, nullptr);
+
+      for (const std::string& waiting : duplicates->waiting)
+      {
+        add_result(waiting, hash, result, &duplicates->file_name);
+      }
+      duplicates->waiting.clear();
+    }));
+  }
+
+  pool.waitForDone();
+
+  if (!latencies.empty())
+  {
+    std::sort(latencies.begin(), latencies.end());
+    statistics.median_milliseconds = latencies[(latencies.size() - 1) / 2];
+    statistics.p95_milliseconds = latencies[(latencies.size() - 1) * 95 / 100];
+    statistics.max_milliseconds = latencies.back();
+  }
+
+  statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  return statistics;
+}
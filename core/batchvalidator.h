@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef BATCHVALIDATOR_H
+#define BATCHVALIDATOR_H
+
+#include <QStringList>
+
+#include <string>
+#include <vector>
+
+class Sink;
+
+/*
+ * Checks many configuration files, like the ones written for each host by the command line tool,
+ * with "syslog-ng -s -f FILE", running a number of validator processes at the same time.
+ * Files with the same contents are checked only once.
+ * Blocks until every file is checked, the GUI uses Validator instead.
+ */
+class BatchValidator
+{
+public:
+  struct Statistics
+  {
+    std::size_t configs = 0;
+    std::size_t runs = 0;       // validator processes run, the duplicates are not checked again
+    std::size_t valid = 0;
+    std::size_t invalid = 0;
+    std::size_t failed = 0;     // unreadable, timed out or the validator could not be started
+    double seconds = 0;         // wall-clock time of the whole batch
+    qint64 median_milliseconds = 0;  // latency of the runs
+    qint64 p95_milliseconds = 0;
+    qint64 max_milliseconds = 0;
+  };
+
+private:
+  QString program = "syslog-ng";
+  QStringList arguments { "-s", "-f" };
+  int timeout = 60000;
+  unsigned int n_processes = 0;
+
+public:
+  /*
+   * See Validator::set_program.
+   */
+  void set_program(const QString& program, const QStringList& arguments);
+
+  /*
+   * @n_processes: number of validators running at the same time, 0 means one per core.
+   */
+  void set_processes(unsigned int n_processes);
+  void set_timeout(int milliseconds);
+
+  /*
+   * Checks the @file_names files and writes a JSON object for each of them to @report, one per line,
+   * as soon as its result is known, so the lines are in the order of completion:
+   * {"file":"web1/syslog-ng.conf","status":"valid","milliseconds":41,"sha1":"...","message":""}
+   * The lines of duplicates have a "duplicate_of" member with the name of the file that was actually checked.
+   */
+  Statistics run(const std::vector<std::string>& file_names, Sink& report) const;
+};
+
+#endif  // BATCHVALIDATOR_H
@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "config.h"
+#include "schema.h"
+#include "schemacache.h"
+#include "constraints.h"
+#include "parallel.h"
+#include "sink.h"
+
+#include <QDirIterator>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <stdexcept>
+
+// Typelist and TypeAt from the Loki library, described in Alexandrescu's Modern C++ Design book
+template <class T, class U>
+struct Typelist
+{
+  typedef T Head;
+  typedef U Tail;
+};
+
+class NullType {};
+
+typedef Typelist<Source,
+  Typelist<Destination,
+  Typelist<Filter,
+  Typelist<Template,
+  Typelist<Rewrite,
+  Typelist<Parser,
+  Typelist<Options, NullType> > > > > > > ObjectTypes;
+
+template<class TList, unsigned int index>
+struct TypeAt;
+
+template <class Head, class Tail>
+struct TypeAt<Typelist<Head, Tail>, 0>
+{
+  typedef Head Result;
+};
+
+template<class Head, class Tail, unsigned int index>
+struct TypeAt<Typelist<Head, Tail>, index>
+{
+  typedef typename TypeAt<Tail, index - 1>::Result Result;
+};
+
+template<ObjectType type>
+Object* create_object(std::shared_ptr<const ObjectSchema> schema)
+{
+  return new typename TypeAt<ObjectTypes, (int) type>::Result(std::move(schema));
+}
+
+// indexed by ObjectType
+Object* (* const create_object_table[])(std::shared_ptr<const ObjectSchema>) = {
+  create_object<ObjectType::SOURCE>,
+  create_object<ObjectType::DESTINATION>,
+  create_object<ObjectType::FILTER>,
+  create_object<ObjectType::TEMPLATE>,
+  create_object<ObjectType::REWRITE>,
+  create_object<ObjectType::PARSER>,
+  create_object<ObjectType::OPTIONS>
+};
+
+/*
+ * Create a default Object from @schema, the extern options are set later by Config.
+ * The Object and its Options keep sharing @schema, which holds their names, descriptions, values.
+ */
+Object* create_default_object(const std::shared_ptr<const ObjectSchema>& schema)
+{
+  Object* object = create_object_table[static_cast<int>(schema->object_type)](schema);
+
+  for (const OptionSchema& option_schema : schema->options)
+  {
+    // aliasing constructor, the option schemas are owned by the object schema
+    Option option(std::shared_ptr<const OptionSchema>(schema, &option_schema), option_schema.option_type);
+
+    if (option_schema.has_default)
+    {
+      option.set_default(option_schema.default_value);
+    }
+
+    object->add_option(std::move(option));
+  }
+
+  return object;
+}
+
+/*
+ * Create an Object without options, used for listing and drawing it.
+ */
+Object* create_header_object(const std::string& name, const std::string& type, ObjectType object_type, const std::string& description)
+{
+  std::shared_ptr<ObjectSchema> schema = std::make_shared<ObjectSchema>();
+  schema->name = Atom(name);
+  schema->type = Atom(type);
+  schema->object_type = object_type;
+  schema->description = description;
+
+  return create_object_table[static_cast<int>(object_type)](std::move(schema));
+}
+
+
+Config::Config()
+{
+  default_objects.reserve(n_builtin_objects);
+
+  for (std::size_t i = 0; i < n_builtin_objects; i++)
+  {
+    const BuiltinObject& builtin = builtin_objects[i];
+
+    DefaultObject default_object;
+    default_object.header.reset(create_header_object(builtin.name, builtin.type, builtin.object_type, builtin.description));
+    default_object.load = [&builtin]() {
+      ObjectSchema schema = to_schema(builtin);
+      compile_constraints(schema);
+      return std::make_shared<const ObjectSchema>(std::move(schema));
+    };
+
+    default_objects.push_back(std::move(default_object));
+  }
+
+  setup_default_objects();
+}
+
+Config::Config(const std::string& dir_name, unsigned int n_threads)
+{
+  // sorted, so the default Objects are in the same order regardless of the directory listing
+  std::vector<QFileInfo> files;
+
+  QDirIterator it(QString::fromStdString(dir_name));
+  while (it.hasNext())
+  {
+    it.next();
+    if (it.fileInfo().isFile())
+    {
+      files.push_back(it.fileInfo());
+    }
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const QFileInfo& a, const QFileInfo& b)->bool {
+              return a.filePath() < b.filePath();
+            });
+
+  // only the yaml files changed since the last run are parsed
+  SchemaCache cache(SchemaCache::default_file_name());
+
+  // each thread writes only its own slot, the results are merged in file order
+  std::vector<ObjectSchema> schemas(files.size());
+
+  parallel_for(files.size(), n_threads, [&](std::size_t i) {
+    if (!cache.find(files[i], schemas[i]))
+    {
+      schemas[i] = read_schema(files[i].filePath().toStdString());
+      cache.insert(files[i], schemas[i]);
+    }
+  });
+
+  cache.save();
+
+  default_objects.reserve(schemas.size());
+
+  for (ObjectSchema& schema : schemas)
+  {
+    add_default_object(std::move(schema));
+  }
+
+  setup_default_objects();
+}
+
+void Config::setup_default_objects()
+{
+  index_default_objects();
+
+  const Options& options_global = static_cast<const Options&>(get_default_object("global", "options"));
+  global_options = std::make_unique<GlobalOptions>(options_global, &generation);
+}
+
+void Config::index_default_objects()
+{
+  // sorted by type first, so each type is a contiguous range
+  std::sort(default_objects.begin(), default_objects.end(),
+            [](const DefaultObject& a, const DefaultObject& b)->bool {
+              const int type = a.header->get_type().compare(b.header->get_type());
+              return type < 0 || (type == 0 && a.header->get_name() < b.header->get_name());
+            });
+
+  default_object_headers.clear();
+  default_object_headers.reserve(default_objects.size());
+  registry.clear();
+
+  for (std::size_t i = 0; i < default_objects.size(); i++)
+  {
+    const Object& header = *default_objects[i].header;
+    default_object_headers.push_back(&header);
+
+    TypeIndex& type_index = registry[header.get_type()];
+    if (type_index.names.empty())
+    {
+      type_index.first = i;
+    }
+    type_index.last = i + 1;
+    type_index.names.emplace(header.get_name(), i);
+  }
+}
+
+DefaultObjectRange Config::get_default_objects(const std::string& type) const
+{
+  auto it = registry.find(type);
+  if (it == registry.end())
+  {
+    return DefaultObjectRange(default_object_headers.cend(), default_object_headers.cend());
+  }
+
+  const TypeIndex& type_index = it->second;
+  return DefaultObjectRange(default_object_headers.cbegin() + type_index.first,
+                            default_object_headers.cbegin() + type_index.last);
+}
+
+const Object& Config::get_default_object(const std::string& name, const std::string& type) const
+{
+  auto type_it = registry.find(type);
+  if (type_it != registry.end())
+  {
+    auto name_it = type_it->second.names.find(name);
+    if (name_it != type_it->second.names.end())
+    {
+      return load_default_object(default_objects[name_it->second]);
+    }
+  }
+
+  throw std::out_of_range("unknown default object: " + type + " " + name);
+}
+
+const Object& Config::load_default_object(const DefaultObject& default_object) const
+{
+  std::lock_guard<std::recursive_mutex> lock(load_mutex);
+
+  if (default_object.object)
+  {
+    return *default_object.object;
+  }
+
+  std::unique_ptr<Object> object(create_default_object(default_object.load()));
+
+  // some objects have tls or value-pairs options, which are creted from separate yaml files and need to be set after
+  for (Option& option : object->get_options())
+  {
+    if (option.get_type() == OptionType::OPTIONS)
+    {
+      const Options& options = static_cast<const Options&>(get_default_object(option.get_schema().type.str(), "options"));
+      option.set_options(options);
+    }
+  }
+
+  default_object.object = std::move(object);
+  default_object.load = nullptr;  // the schema is not needed anymore
+
+  return *default_object.object;
+}
+
+std::shared_ptr<Object> Config::create_object(const std::string& name, const std::string& type)
+{
+  std::shared_ptr<Object> object = get_default_object(name, type).clone(arena);
+  object->get_generation().set_parent(&generation);
+
+  return object;
+}
+
+Options& Config::get_global_options()
+{
+  return global_options->get_options();
+}
+
+const Options& Config::get_global_options() const
+{
+  return global_options->get_options();
+}
+
+const Config::ObjectStatements& Config::get_object_statements() const
+{
+  return *object_statements;
+}
+
+const Config::LogStatements& Config::get_log_statements() const
+{
+  return *log_statements;
+}
+
+const StatementIndex& Config::get_index() const
+{
+  return index;
+}
+
+/*
+ * @return: returns a shared_ptr to the element of @handle, erasing it from @statements when the last copy is gone.
+ * The deleter only holds a weak_ptr, if @statements is destroyed first, the element is already gone.
+ */
+template<typename Statement>
+std::shared_ptr<Statement> share_statement(const std::shared_ptr< SlotMap< Statement, ArenaAllocator<Statement> > >& statements,
+                                           typename SlotMap< Statement, ArenaAllocator<Statement> >::Handle handle,
+                                           Generation* generation)
+{
+  std::weak_ptr< SlotMap< Statement, ArenaAllocator<Statement> > > weak_statements = statements;
+  generation->bump();
+
+  // the control block goes in the arena too, @generation outlives @statements
+  return std::shared_ptr<Statement>(statements->find(handle),
+                                    [weak_statements, handle, generation](const Statement *) {
+                                      if (auto statements = weak_statements.lock())
+                                      {
+                                        statements->erase(handle);
+                                        generation->bump();
+                                      }
+                                    },
+                                    ArenaAllocator<Statement>(statements->get_allocator()));
+}
+
+std::shared_ptr<ObjectStatement> Config::add_object_statement(const std::string& id)
+{
+  return share_statement(object_statements, object_statements->emplace(id, arena, &generation, &index), &generation);
+}
+
+std::shared_ptr<LogStatement> Config::add_log_statement()
+{
+  const Options& log_options = static_cast<const Options&>(get_default_object("log", "options"));
+
+  return share_statement(log_statements, log_statements->emplace(log_options, arena, &generation, &index), &generation);
+}
+
+std::uint64_t Config::get_generation() const
+{
+  return generation.get();
+}
+
+const Arena::Statistics& Config::get_allocation_statistics() const
+{
+  return arena->get_statistics();
+}
+
+bool Config::release_memory()
+{
+  return arena->reset();
+}
+
+void Config::parse_yaml(const std::string& file_name)
+{
+  add_default_object(read_schema(file_name));
+  index_default_objects();
+}
+
+void Config::add_default_object(ObjectSchema schema)
+{
+  compile_constraints(schema);
+  std::shared_ptr<const ObjectSchema> shared_schema = std::make_shared<const ObjectSchema>(std::move(schema));
+
+  DefaultObject default_object;
+  default_object.header.reset(create_object_table[static_cast<int>(shared_schema->object_type)](shared_schema));
+  default_object.load = [shared_schema]() {
+    return shared_schema;
+  };
+
+  default_objects.push_back(std::move(default_object));
+}
+
+const std::string Config::to_string() const
+{
+  std::string config;
+  StringSink sink(config);
+  write(sink);
+
+  return config;
+}
+
+void Config::write(Sink& sink, unsigned int n_threads, const Substitutions* substitutions) const
+{
+  sink << "@version: 3.7\n";
+  sink << "@include \"scl.conf\"\n\n";
+
+  global_options->write(sink, substitutions);
+
+  if (n_threads == 0)
+  {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  if (n_threads == 1)
+  {
+    for (const ObjectStatement& object_statement : *object_statements)
+    {
+      object_statement.write(sink, substitutions);
+    }
+
+    for (const LogStatement& log_statement : *log_statements)
+    {
+      log_statement.write(sink, substitutions);
+    }
+
+    return;
+  }
+
+  /*
+   * The statements are rendered by the same threads from the first to the last, 16 in a row into one buffer,
+   * while this thread writes the finished buffers in order, at most 64 statements per thread are held.
+   * Each statement is rendered by one thread, but an Object can be held by several ObjectStatements
+   * and a substitute can replace several Objects, so their caches are filled here before the threads start.
+   */
+  std::vector<const ObjectStatement*> object_statement_list;
+  object_statement_list.reserve(object_statements->size());
+  for (const ObjectStatement& object_statement : *object_statements)
+  {
+    object_statement_list.push_back(&object_statement);
+
+    for (const std::shared_ptr<const Object>& object : object_statement.get_objects())
+    {
+      if (index.count_object_statements(*object) > 1)
+      {
+        object->to_string();
+      }
+    }
+  }
+
+  if (substitutions)
+  {
+    for (const auto& substitution : *substitutions)
+    {
+      substitution.second->to_string();
+    }
+  }
+
+  std::vector<const LogStatement*> log_statement_list;
+  log_statement_list.reserve(log_statements->size());
+  for (const LogStatement& log_statement : *log_statements)
+  {
+    log_statement_list.push_back(&log_statement);
+  }
+
+  const std::size_t n_object_statements = object_statement_list.size();
+  const std::size_t n_statements = n_object_statements + log_statement_list.size();
+  const std::size_t chunk_size = 16;
+
+  parallel_ordered((n_statements + chunk_size - 1) / chunk_size, n_threads, 4 * n_threads,
+                   [&](std::size_t chunk, std::string& buffer) {
+                     StringSink buffer_sink(buffer);
+                     for (std::size_t i = chunk * chunk_size; i < std::min(n_statements, (chunk + 1) * chunk_size); i++)
+                     {
+                       if (i < n_object_statements)
+                       {
+                         object_statement_list[i]->write(buffer_sink, substitutions);
+                       }
+                       else
+                       {
+                         log_statement_list[i - n_object_statements]->write(buffer_sink, substitutions);
+                       }
+                     }
+                   },
+                   [&](std::size_t, const std::string& buffer) {
+                     sink << buffer;
+                   });
+}
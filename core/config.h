@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include "object.h"
+#include "slotmap.h"
+#include "statementindex.h"
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+/*
+ * Contiguous range of the default Objects of the same type, without their options.
+ */
+class DefaultObjectRange
+{
+public:
+  typedef std::vector<const Object*>::const_iterator const_iterator;
+
+  DefaultObjectRange(const_iterator first, const_iterator last) :
+    first(first),
+    last(last)
+  {}
+
+  const_iterator begin() const { return first; }
+  const_iterator end() const { return last; }
+
+private:
+  const_iterator first;
+  const_iterator last;
+};
+
+/*
+ * Holds the default Objects created from the yaml files
+ * and the syslog-ng configuration elements.
+ */
+class Config
+{
+  /*
+   * Only the name, type and description of a default Object is known up front,
+   * its options are created when the Object is first requested.
+   */
+  struct DefaultObject
+  {
+    std::unique_ptr<const Object> header;  // Object without options, enough for listing and drawing it
+    mutable std::function<std::shared_ptr<const ObjectSchema>()> load;
+    mutable std::unique_ptr<const Object> object;
+  };
+
+  // All the Objects used in the configuration are copied from these, sorted by type and name
+  std::vector<DefaultObject> default_objects;
+  std::vector<const Object*> default_object_headers;
+  mutable std::recursive_mutex load_mutex;
+
+  // position of the default Objects of a type in @default_objects, and of each Object by name
+  struct TypeIndex
+  {
+    std::size_t first = 0;
+    std::size_t last = 0;
+    std::unordered_map<std::string, std::size_t> names;
+  };
+  std::unordered_map<std::string, TypeIndex> registry;
+
+  // memory of the configuration elements below and the Objects copied into them
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+
+  // counts the changes of the configuration elements below
+  Generation generation;
+
+  std::unique_ptr<GlobalOptions> global_options;
+
+  // cross references of the statements below, which update it, so it's destroyed after them
+  StatementIndex index;
+
+public:
+  typedef SlotMap< ObjectStatement, ArenaAllocator<ObjectStatement> > ObjectStatements;
+  typedef SlotMap< LogStatement, ArenaAllocator<LogStatement> > LogStatements;
+
+private:
+  // shared with the deleters of the statement handles, which are no-ops after Config is destroyed
+  std::shared_ptr<ObjectStatements> object_statements = std::make_shared<ObjectStatements>(ArenaAllocator<ObjectStatement>(arena));
+  std::shared_ptr<LogStatements> log_statements = std::make_shared<LogStatements>(ArenaAllocator<LogStatement>(arena));
+
+public:
+  /*
+   * The default Objects are created from the yaml files compiled in at build time.
+   */
+  Config();
+
+  /*
+   * Override for custom yaml files.
+   * @dir_name: directory holding the yaml files.
+   * Parsed files are cached, see SchemaCache.
+   * @n_threads: number of threads loading the yaml files, 0 means one per core.
+   */
+  explicit Config(const std::string& dir_name, unsigned int n_threads = 0);
+
+  /*
+   * @return: returns the default Objects of @type without their options, for the palette.
+   */
+  DefaultObjectRange get_default_objects(const std::string& type) const;
+
+  /*
+   * @name, @type: uniquely indentifies an Object.
+   * @return: returns a default Object to be copied and stored in an ObjectIcon.
+   * The Object is created with its options on the first call.
+   * Throws std::out_of_range if there is no such Object.
+   */
+  const Object& get_default_object(const std::string& name, const std::string& type) const;
+
+  /*
+   * @return: returns a copy of the default Object, allocated from the arena of the configuration.
+   * Usually the returned shared_ptr is held by an ObjectIcon.
+   * Throws std::out_of_range if there is no such Object.
+   */
+  std::shared_ptr<Object> create_object(const std::string& name, const std::string& type);
+
+  Options& get_global_options();
+  const Options& get_global_options() const;
+  const ObjectStatements& get_object_statements() const;
+  const LogStatements& get_log_statements() const;
+
+  /*
+   * @return: returns the cross references of the statements, e.g. the LogStatements holding an ObjectStatement.
+   */
+  const StatementIndex& get_index() const;
+
+  /*
+   * The same ObjectStatement can be added to multiple LogStatements.
+   * @id: identifier of the new ObjectStatement.
+   * @return: Usually the returned shared_ptr is held by an ObjectStatementIcon.
+   * The ObjectStatement is removed from the Config when the last copy of it is gone.
+   */
+  std::shared_ptr<ObjectStatement> add_object_statement(const std::string& id);
+
+  /*
+   * The new LogStatement has the default log options.
+   * @return: Usually the returned shared_ptr is held by an LogStatementIcon.
+   *
+   * Should be unique_ptr, but shared_ptr is less code:
+   * std::unique_ptr< Log, std::function<void(const LogStatement *)> >
+   */
+  std::shared_ptr<LogStatement> add_log_statement();
+
+  /*
+   * @return: returns the number of changes made to the configuration so far.
+   * Every Option, Filter and statement change counts, so comparing two values tells if anything has changed in between.
+   */
+  std::uint64_t get_generation() const;
+
+  /*
+   * @return: returns the number of allocations and bytes used by the configuration elements.
+   */
+  const Arena::Statistics& get_allocation_statistics() const;
+
+  /*
+   * Releases the memory of the statements and Objects at once, call it when they are all destroyed, like for a new configuration.
+   * @return: returns false if any of them is still alive, then nothing is released.
+   */
+  bool release_memory();
+
+  /*
+   * Read the @file_name yaml file and index a default Object from it.
+   */
+  void parse_yaml(const std::string& file_name);
+
+  /*
+   * @return: returns a syslog-ng configuration file.
+   * The output should go in a file, and used with syslog-ng.
+   */
+  const std::string to_string() const;
+
+  /*
+   * Writes the syslog-ng configuration file to @sink piece by piece, the same as to_string().
+   * Only the statements changed since the last call are rendered again.
+   * @n_threads: number of threads rendering the statements, 0 means one per core.
+   * The output is the same for any number of threads, the configuration must not be edited meanwhile.
+   * One thread is the default, more have not been shown to be faster yet.
+   * @substitutions: see Substitutions.
+   */
+  void write(Sink& sink, unsigned int n_threads = 1, const Substitutions* substitutions = nullptr) const;
+
+private:
+  /*
+   * Indexes the default Objects and creates the global options.
+   * Called once by the constructors.
+   */
+  void setup_default_objects();
+
+  /*
+   * Sorts @default_objects and rebuilds the @registry.
+   */
+  void index_default_objects();
+
+  /*
+   * Index @schema in the @default_objects vector, the Object is created on demand.
+   */
+  void add_default_object(ObjectSchema schema);
+
+  /*
+   * Create the Object of @default_object with its options, unless it already exists.
+   */
+  const Object& load_default_object(const DefaultObject& default_object) const;
+
+  // non copyable, the statement handles refer to this Config
+  Config(const Config&) = delete;
+  Config& operator=(const Config&) = delete;
+};
+
+#endif  // CONFIG_H
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "constraints.h"
+#include "schema.h"
+#include "object.h"
+#include "config.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+  /*
+   * @return: returns the index of the option named @name in @schema.
+   * Throws std::runtime_error if there is no such option, @option names the one referring to it.
+   */
+  std::size_t find_index(const ObjectSchema& schema, const OptionSchema& option, const Atom& name)
+  {
+    for (std::size_t i = 0; i < schema.options.size(); i++)
+    {
+      if (schema.options[i].name == name)
+      {
+        return i;
+      }
+    }
+
+    throw std::runtime_error(schema.name.str() + ": " + option.name.str() + ": unknown option " + name.str());
+  }
+
+  // absolute, not a directory, no control characters, the macros of syslog-ng are allowed
+  bool is_valid_path(const std::string& path)
+  {
+    if (path.front() != '/' || path.back() == '/')
+    {
+      return false;
+    }
+
+    return std::none_of(path.begin(), path.end(), [](const unsigned char c) {
+      return c < 0x20 || c == 0x7f;
+    });
+  }
+
+  /*
+   * @return: true if every value of @set is one of @values, the values of a set option
+   * are separated by commas or spaces, see Dialog.
+   */
+  bool is_subset(const std::string& set, const std::vector<Atom>& values)
+  {
+    std::size_t begin = 0;
+
+    while (begin < set.size())
+    {
+      std::size_t end = set.find_first_of(", ", begin);
+      if (end == std::string::npos)
+      {
+        end = set.size();
+      }
+
+      const std::string_view value(set.data() + begin, end - begin);
+      if (!value.empty() &&
+          std::none_of(values.begin(), values.end(), [value](const Atom& atom) { return atom.str() == value; }))
+      {
+        return false;
+      }
+
+      begin = end + 1;
+    }
+
+    return true;
+  }
+}
+
+
+ConstraintTable::ConstraintTable(const ObjectSchema& schema)
+{
+  static const Atom string("string"), number("number"), list("list"), set("set");
+
+  for (std::size_t i = 0; i < schema.options.size(); i++)
+  {
+    const OptionSchema& option = schema.options[i];
+
+    if (option.type != string && option.type != number && option.type != list && option.type != set)
+    {
+      nested.push_back(i);
+      continue;
+    }
+
+    Entry entry { i, 0, option.minimum, option.maximum, std::regex(), {}, {} };
+
+    if (option.required)
+    {
+      entry.checks |= REQUIRED;
+    }
+
+    if (option.type == number &&
+        (option.minimum != std::numeric_limits<int>::min() || option.maximum != std::numeric_limits<int>::max()))
+    {
+      entry.checks |= RANGE;
+    }
+
+    if (option.type == string && !option.pattern.empty())
+    {
+      try
+      {
+        entry.pattern = std::regex(option.pattern, std::regex::ECMAScript | std::regex::optimize);
+      }
+      catch (const std::regex_error& e)
+      {
+        throw std::runtime_error(schema.name.str() + ": " + option.name.str() + ": invalid pattern: " + e.what());
+      }
+
+      entry.checks |= PATTERN;
+    }
+
+    if (option.type == string && option.path)
+    {
+      entry.checks |= PATH;
+    }
+
+    if (option.type == set && !option.values.empty())
+    {
+      entry.checks |= VALUES;
+    }
+
+    for (const Atom& conflict : option.conflicts)
+    {
+      entry.conflicts.push_back(find_index(schema, option, conflict));
+    }
+
+    for (const Atom& dependency : option.dependencies)
+    {
+      entry.dependencies.push_back(find_index(schema, option, dependency));
+    }
+
+    if (!entry.conflicts.empty() || !entry.dependencies.empty())
+    {
+      entry.checks |= RELATIONS;
+    }
+
+    if (entry.checks)
+    {
+      entries.push_back(std::move(entry));
+    }
+  }
+}
+
+bool ConstraintTable::empty() const
+{
+  return entries.empty() && nested.empty();
+}
+
+void ConstraintTable::check(const Object& object, std::vector<ConstraintViolation>& violations) const
+{
+  const OptionSchema* const option_schemas = object.get_schema().options.data();
+
+  for (const Entry& entry : entries)
+  {
+    const Option* option = find_option(object, entry.option);
+    if (!option)
+    {
+      continue;
+    }
+
+    const std::size_t index = option - object.get_options().data();
+    const auto add_violation = [&](std::string message) {
+      violations.push_back(ConstraintViolation { &object, index, std::move(message) });
+    };
+
+    const Option::Values& values = option->get_values();
+    bool unset = false;
+
+    switch (option->get_type())
+    {
+      case OptionType::STRING:
+      {
+        const std::string& value = std::get<StringValues>(values).current_value;
+        unset = value.empty();
+
+        if (unset)
+        {
+          break;
+        }
+
+        if ((entry.checks & PATTERN) && !std::regex_match(value, entry.pattern))
+        {
+          add_violation("\"" + value + "\" doesn't match " + option_schemas[entry.option].pattern);
+        }
+
+        if ((entry.checks & PATH) && !is_valid_path(value))
+        {
+          add_violation("\"" + value + "\" is not an absolute file path");
+        }
+        break;
+      }
+      case OptionType::NUMBER:
+      {
+        const int value = std::get<NumberValues>(values).current_value;
+        unset = value == -1;
+
+        if (!unset && (entry.checks & RANGE) && (value < entry.minimum || value > entry.maximum))
+        {
+          add_violation(std::to_string(value) + " is out of range " + std::to_string(entry.minimum) + ".." + std::to_string(entry.maximum));
+        }
+        break;
+      }
+      case OptionType::LIST:
+        unset = std::get<ListValues>(values).current_value == -1;
+        break;
+      case OptionType::SET:
+      {
+        const std::string& value = std::get<SetValues>(values).current_value;
+        unset = value.empty();
+
+        if (!unset && (entry.checks & VALUES) && !is_subset(value, option_schemas[entry.option].values))
+        {
+          add_violation("\"" + value + "\" has unknown values");
+        }
+        break;
+      }
+      case OptionType::OPTIONS:
+        break;
+    }
+
+    if (unset && (entry.checks & REQUIRED))
+    {
+      add_violation("is required");
+    }
+
+    if (!(entry.checks & RELATIONS) || unset || !option->has_changed())
+    {
+      continue;
+    }
+
+    for (const std::size_t conflict : entry.conflicts)
+    {
+      const Option* other = find_option(object, conflict);
+      if (other && other->has_changed())
+      {
+        add_violation("can't be set together with " + other->get_name());
+      }
+    }
+
+    for (const std::size_t dependency : entry.dependencies)
+    {
+      const Option* other = find_option(object, dependency);
+      if (!other || !other->has_changed())
+      {
+        add_violation("requires " + option_schemas[dependency].name.str() + " to be set");
+      }
+    }
+  }
+
+  for (const std::size_t index : nested)
+  {
+    const Option* option = find_option(object, index);
+    if (option && option->get_type() == OptionType::OPTIONS && std::get<ExternValues>(option->get_values()).options)
+    {
+      check_constraints(option->get_options(), violations);
+    }
+  }
+}
+
+const Option* ConstraintTable::find_option(const Object& object, std::size_t index)
+{
+  const OptionVector& options = object.get_options();
+  const OptionSchema* const option_schema = &object.get_schema().options[index];
+
+  // the options of the default Objects and their copies are in the order of the schema
+  if (index < options.size() && &options[index].get_schema() == option_schema)
+  {
+    return &options[index];
+  }
+
+  for (const Option& option : options)
+  {
+    if (&option.get_schema() == option_schema)
+    {
+      return &option;
+    }
+  }
+
+  return nullptr;
+}
+
+
+void compile_constraints(ObjectSchema& schema)
+{
+  std::shared_ptr<const ConstraintTable> constraints = std::make_shared<const ConstraintTable>(schema);
+  schema.constraints = constraints->empty() ? nullptr : std::move(constraints);
+}
+
+void check_constraints(const Object& object, std::vector<ConstraintViolation>& violations)
+{
+  if (const ConstraintTable* constraints = object.get_schema().constraints.get())
+  {
+    constraints->check(object, violations);
+  }
+}
+
+std::vector<ConstraintViolation> check_constraints(const Config& config)
+{
+  std::vector<ConstraintViolation> violations;
+
+  check_constraints(config.get_global_options(), violations);
+
+  for (const ObjectStatement& object_statement : config.get_object_statements())
+  {
+    for (const std::shared_ptr<const Object>& object : object_statement.get_objects())
+    {
+      check_constraints(*object, violations);
+    }
+  }
+
+  for (const LogStatement& log_statement : config.get_log_statements())
+  {
+    check_constraints(log_statement.get_options(), violations);
+  }
+
+  return violations;
+}
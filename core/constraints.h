@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CONSTRAINTS_H
+#define CONSTRAINTS_H
+
+#include <regex>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+struct ObjectSchema;
+class Object;
+class Option;
+class Config;
+
+struct ConstraintViolation
+{
+  const Object* object;
+  std::size_t option;  // index in the options of @object
+  std::string message;
+};
+
+/*
+ * The constraints of an ObjectSchema compiled into a table, so checking an Object needs no parsing:
+ * the patterns are built into regexes and the names of conflicting and required options
+ * are resolved to indices in the schema, once, when Config loads the schema.
+ * The table is immutable, it can be used from multiple threads.
+ */
+class ConstraintTable
+{
+  enum Check : unsigned int
+  {
+    REQUIRED = 1 << 0,
+    RANGE = 1 << 1,
+    PATTERN = 1 << 2,
+    PATH = 1 << 3,
+    VALUES = 1 << 4,
+    RELATIONS = 1 << 5,
+  };
+
+  struct Entry
+  {
+    std::size_t option;  // index in the options of the schema
+    unsigned int checks;
+    int minimum;
+    int maximum;
+    std::regex pattern;
+    std::vector<std::size_t> conflicts;
+    std::vector<std::size_t> dependencies;
+  };
+
+  std::vector<Entry> entries;
+
+  // indices of the options holding nested Options, checked against their own schemas
+  std::vector<std::size_t> nested;
+
+public:
+  /*
+   * Throws std::runtime_error if a pattern is not a valid regex or a related option doesn't exist.
+   */
+  explicit ConstraintTable(const ObjectSchema& schema);
+
+  bool empty() const;
+
+  /*
+   * Appends the violated constraints of @object and its nested options to @violations.
+   * @object has to be created from the compiled schema.
+   */
+  void check(const Object& object, std::vector<ConstraintViolation>& violations) const;
+
+private:
+  /*
+   * @return: returns the option of @object created from the @index-th option of its schema, nullptr if there is none.
+   */
+  static const Option* find_option(const Object& object, std::size_t index);
+};
+
+/*
+ * Compiles the constraints of @schema into @schema.constraints, left nullptr if there are none.
+ * Throws like ConstraintTable.
+ */
+void compile_constraints(ObjectSchema& schema);
+
+/*
+ * Checks @object and its nested options against the compiled constraints of their schemas,
+ * does nothing if its schema has no constraints.
+ */
+void check_constraints(const Object& object, std::vector<ConstraintViolation>& violations);
+
+/*
+ * Checks the global options, the Objects of every ObjectStatement and the options of every LogStatement in one pass.
+ */
+std::vector<ConstraintViolation> check_constraints(const Config& config);
+
+#endif  // CONSTRAINTS_H
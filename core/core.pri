@@ -0,0 +1,5 @@
+# linking the core library, included by the projects using the model
+INCLUDEPATH += $$PWD
+# the library is in the build tree, see DESTDIR in core.pro and BUILD_ROOT in .qmake.conf
+LIBS += -L$$BUILD_ROOT/build/lib -lsyslog-ng-config-core -lyaml-cpp
+PRE_TARGETDEPS += $$BUILD_ROOT/build/lib/libsyslog-ng-config-core.a
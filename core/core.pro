@@ -0,0 +1,57 @@
+TEMPLATE = lib
+CONFIG += c++17 staticlib
+TARGET = syslog-ng-config-core
+DESTDIR = $$BUILD_ROOT/build/lib
+OBJECTS_DIR = ../build/core
+MOC_DIR = ../build/core
+# the model only needs QtCore, the widgets are in src
+QT = core
+
+SOURCES += \
+    arena.cpp \
+    atom.cpp \
+    sink.cpp \
+    schema.cpp \
+    schemacache.cpp \
+    option.cpp \
+    object.cpp \
+    statementindex.cpp \
+    config.cpp \
+    importer.cpp \
+    project.cpp \
+    validator.cpp \
+    batchvalidator.cpp \
+    constraints.cpp \
+    linter.cpp
+
+HEADERS += \
+    arena.h \
+    atom.h \
+    generation.h \
+    sink.h \
+    schema.h \
+    schemacache.h \
+    slotmap.h \
+    indexedvector.h \
+    parallel.h \
+    option.h \
+    object.h \
+    statementindex.h \
+    config.h \
+    importer.h \
+    project.h \
+    validator.h \
+    batchvalidator.h \
+    constraints.h \
+    linter.h
+
+# the yaml files are compiled into the library, see schemagen
+SCHEMAS = $$files(../objects/*.yml)
+
+schemagen.input = SCHEMAS
+schemagen.output = builtin_schemas.cpp
+schemagen.commands = $$OUT_PWD/../schemagen/schemagen ${QMAKE_FILE_OUT} ${QMAKE_FILE_IN}
+schemagen.depends = $$OUT_PWD/../schemagen/schemagen
+schemagen.variable_out = GENERATED_SOURCES
+schemagen.CONFIG += combine
+QMAKE_EXTRA_COMPILERS += schemagen
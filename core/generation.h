@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef GENERATION_H
+#define GENERATION_H
+
+#include <cstdint>
+
+/*
+ * Edit counter of a configuration element, increased by every change of the element.
+ * Two equal values mean that nothing has changed in between.
+ * The counters form a tree: Options count in their Object's counter, Objects in their
+ * ObjectStatement's counter, statements in the Config's counter, so a change bumps
+ * every counter up to the Config's.
+ * Not synchronized: the configuration is edited from one thread at a time,
+ * and nothing reads the counters while it's being edited.
+ */
+class Generation
+{
+  std::uint64_t value = 0;
+  Generation* parent;
+
+public:
+  explicit Generation(Generation* parent = nullptr) :
+    parent(parent)
+  {}
+
+  /*
+   * The copy starts from the value of @other without a parent,
+   * the container of the copy links it into its own tree.
+   */
+  Generation(const Generation& other) :
+    value(other.value),
+    parent(nullptr)
+  {}
+
+  // the parent is not assigned either, use set_parent
+  Generation& operator=(const Generation&) = delete;
+
+  std::uint64_t get() const { return value; }
+
+  void bump()
+  {
+    for (Generation* generation = this; generation; generation = generation->parent)
+    {
+      generation->value++;
+    }
+  }
+
+  Generation* get_parent() const { return parent; }
+  void set_parent(Generation* parent) { this->parent = parent; }
+};
+
+#endif  // GENERATION_H
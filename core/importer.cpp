@@ -0,0 +1,769 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "importer.h"
+#include "config.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+namespace
+{
+  struct Token
+  {
+    enum Type { END, WORD, STRING, PUNCTUATION, DIRECTIVE };
+
+    Type type = END;
+    std::string_view text;  // without the quotes of a STRING, and without the @ of a DIRECTIVE
+    char quote = 0;  // the quote of a STRING, ' or "
+    int line = 0;
+
+    bool is(char c) const { return type == PUNCTUATION && text[0] == c; }
+    bool is(std::string_view word) const { return type == WORD && text == word; }
+  };
+
+  /*
+   * Splits the text into tokens, which point into the text, nothing is copied.
+   */
+  class Lexer
+  {
+    std::string_view text;
+    const std::string& file_name;
+    std::size_t position = 0;
+    int line = 1;
+
+    Token peeked;
+    bool has_peeked = false;
+
+  public:
+    Lexer(std::string_view text, const std::string& file_name) :
+      text(text),
+      file_name(file_name)
+    {}
+
+    const Token& peek()
+    {
+      if (!has_peeked)
+      {
+        peeked = scan();
+        has_peeked = true;
+      }
+
+      return peeked;
+    }
+
+    Token next()
+    {
+      if (has_peeked)
+      {
+        has_peeked = false;
+        return peeked;
+      }
+
+      return scan();
+    }
+
+  private:
+    static bool is_space(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    static bool is_delimiter(char c)
+    {
+      return is_space(c) || c == '(' || c == ')' || c == '{' || c == '}' || c == ';' || c == ',' ||
+             c == '"' || c == '\'' || c == '#';
+    }
+
+    Token scan()
+    {
+      // whitespace and comments
+      while (position < text.size())
+      {
+        const char c = text[position];
+
+        if (c == '\n')
+        {
+          line++;
+          position++;
+        }
+        else if (is_space(c))
+        {
+          position++;
+        }
+        else if (c == '#')
+        {
+          position = std::min(text.find('\n', position), text.size());
+        }
+        else
+        {
+          break;
+        }
+      }
+
+      Token token;
+      token.line = line;
+
+      if (position == text.size())
+      {
+        return token;
+      }
+
+      const char c = text[position];
+      const std::size_t start = position;
+
+      if (c == '@')
+      {
+        position = std::min(text.find('\n', position), text.size());
+        token.type = Token::DIRECTIVE;
+        token.text = text.substr(start + 1, position - start - 1);
+      }
+      else if (c == '(' || c == ')' || c == '{' || c == '}' || c == ';' || c == ',')
+      {
+        position++;
+        token.type = Token::PUNCTUATION;
+        token.text = text.substr(start, 1);
+      }
+      else if (c == '"' || c == '\'')
+      {
+        // the escape sequences are kept, the value is written back the same way
+        for (position++; position < text.size() && text[position] != c; position++)
+        {
+          if (text[position] == '\\' && c == '"' && position + 1 < text.size())
+          {
+            position++;
+          }
+
+          if (text[position] == '\n')
+          {
+            line++;
+          }
+        }
+
+        if (position == text.size())
+        {
+          throw std::runtime_error(file_name + ":" + std::to_string(token.line) + ": unterminated string");
+        }
+
+        position++;
+        token.type = Token::STRING;
+        token.text = text.substr(start + 1, position - start - 2);
+        token.quote = c;
+      }
+      else
+      {
+        while (position < text.size() && !is_delimiter(text[position]))
+        {
+          position++;
+        }
+
+        token.type = Token::WORD;
+        token.text = text.substr(start, position - start);
+      }
+
+      return token;
+    }
+  };
+
+  // syslog-ng treats - and _ the same in names, the yaml files use -
+  std::string normalize(std::string_view name)
+  {
+    std::string normalized(name);
+    std::replace(normalized.begin(), normalized.end(), '_', '-');
+
+    return normalized;
+  }
+
+  const std::string statement_types[] = { "source", "destination", "filter", "rewrite", "parser", "template" };
+  const std::string log_member_types[] = { "source", "filter", "destination", "parser", "rewrite" };
+
+  template<std::size_t size>
+  bool contains(const std::string (&types)[size], std::string_view type)
+  {
+    return std::find(types, types + size, type) != types + size;
+  }
+}
+
+/*
+ * Recursive descent parser of one file, the statements are added to the Importer.
+ */
+class ConfigParser
+{
+  Importer& importer;
+  Config& config;
+  const std::string& file_name;
+  Lexer lexer;
+
+public:
+  ConfigParser(Importer& importer, std::string_view text, const std::string& file_name) :
+    importer(importer),
+    config(importer.config),
+    file_name(file_name),
+    lexer(text, file_name)
+  {}
+
+  void parse()
+  {
+    for (Token token = lexer.next(); token.type != Token::END; token = lexer.next())
+    {
+      if (token.type == Token::DIRECTIVE)
+      {
+        parse_directive(token);
+      }
+      else if (token.is("options"))
+      {
+        parse_global_options();
+      }
+      else if (token.is("log"))
+      {
+        parse_log_statement();
+      }
+      else if (token.type == Token::WORD && contains(statement_types, token.text))
+      {
+        parse_object_statement(std::string(token.text));
+      }
+      else
+      {
+        error(token, "unsupported statement: " + std::string(token.text));
+      }
+    }
+  }
+
+private:
+  std::string location(const Token& token) const
+  {
+    return file_name + ":" + std::to_string(token.line);
+  }
+
+  [[noreturn]] void error(const Token& token, const std::string& message) const
+  {
+    throw std::runtime_error(location(token) + ": " + message);
+  }
+
+  void expect(char c)
+  {
+    const Token token = lexer.next();
+    if (!token.is(c))
+    {
+      error(token, std::string("expected ") + c + (token.type == Token::END ? " at the end of the file" : " before " + std::string(token.text)));
+    }
+  }
+
+  Token expect_name()
+  {
+    const Token token = lexer.next();
+    if (token.type != Token::WORD && token.type != Token::STRING)
+    {
+      error(token, "expected a name" + (token.type == Token::END ? " at the end of the file" : " before " + std::string(token.text)));
+    }
+
+    return token;
+  }
+
+  // @version, @define, @module, @requires are not needed by the model
+  void parse_directive(const Token& token)
+  {
+    const std::string_view directive = token.text;
+    if (directive.compare(0, 7, "include") != 0)
+    {
+      return;
+    }
+
+    const std::size_t begin = directive.find_first_of("\"'");
+    const std::size_t end = begin == std::string_view::npos ? begin : directive.find(directive[begin], begin + 1);
+    if (end == std::string_view::npos)
+    {
+      error(token, "expected a quoted file name after @include");
+    }
+
+    importer.include(std::string(directive.substr(begin + 1, end - begin - 1)), file_name);
+  }
+
+  void parse_global_options()
+  {
+    expect('{');
+
+    Options& options = config.get_global_options();
+    while (!lexer.peek().is('}'))
+    {
+      const Token name = expect_name();
+      expect('(');
+      parse_value(find_option(options, name), name);
+      expect(';');
+    }
+
+    expect('}');
+    expect(';');
+  }
+
+  void parse_object_statement(const std::string& type)
+  {
+    const Token id = expect_name();
+    expect('{');
+
+    const std::string id_string(id.text);
+    if (!importer.ids.emplace(id_string, importer.object_statements.size()).second)
+    {
+      error(id, "duplicate statement id: " + id_string);
+    }
+
+    std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(id_string);
+    importer.object_statements.push_back(object_statement);
+
+    if (type == "filter")
+    {
+      if (!lexer.peek().is('}'))
+      {
+        parse_filter_expression(*object_statement);
+      }
+    }
+    else
+    {
+      int position = 0;
+      while (!lexer.peek().is('}'))
+      {
+        object_statement->add_object(parse_driver(type), position++);
+        expect(';');
+      }
+    }
+
+    expect('}');
+    expect(';');
+  }
+
+  // the model only has a chain of filters joined by and/or, each one maybe negated
+  void parse_filter_expression(ObjectStatement& object_statement)
+  {
+    for (int position = 0; ; position++)
+    {
+      bool invert = false;
+      while (lexer.peek().is("not"))
+      {
+        lexer.next();
+        invert = !invert;
+      }
+
+      if (lexer.peek().is('('))
+      {
+        error(lexer.peek(), "parenthesized filter expressions are not supported");
+      }
+
+      std::shared_ptr<Object> object = parse_driver("filter");
+      Filter& filter = static_cast<Filter&>(*object);
+      filter.set_invert(invert);
+      object_statement.add_object(object, position);
+
+      if (lexer.peek().is("and") || lexer.peek().is("or"))
+      {
+        filter.set_next(std::string(lexer.next().text));
+        continue;
+      }
+
+      expect(';');
+      return;
+    }
+  }
+
+  std::shared_ptr<Object> parse_driver(const std::string& type)
+  {
+    const Token name = expect_name();
+
+    std::shared_ptr<Object> object;
+    try
+    {
+      object = config.create_object(normalize(name.text), type);
+    }
+    catch (const std::out_of_range&)
+    {
+      error(name, "unknown " + type + ": " + std::string(name.text));
+    }
+
+    expect('(');
+    parse_arguments(*object);
+
+    return object;
+  }
+
+  // name(value) options, and the value of the unnamed option first, until the closing parenthesis
+  void parse_arguments(Object& object)
+  {
+    std::vector<Token> unnamed;
+
+    for (;;)
+    {
+      const Token token = lexer.next();
+
+      if (token.is(')'))
+      {
+        break;
+      }
+
+      if (token.type == Token::WORD && lexer.peek().is('('))
+      {
+        lexer.next();
+        parse_value(find_option(object, token), token);
+      }
+      else if (token.type == Token::WORD || token.type == Token::STRING)
+      {
+        unnamed.push_back(token);
+      }
+      else if (!token.is(','))
+      {
+        error(token, token.type == Token::END ? "unexpected end of the file" : "unexpected " + std::string(token.text));
+      }
+    }
+
+    if (!unnamed.empty())
+    {
+      auto option = std::find_if(object.get_options().begin(), object.get_options().end(), [&object](const Option& option) {
+        return option.get_name() == object.get_name();
+      });
+
+      if (option == object.get_options().end())
+      {
+        error(unnamed.front(), object.get_name() + " has no unnamed option");
+      }
+
+      set_value(*option, unnamed);
+    }
+  }
+
+  // the opening parenthesis is already read
+  void parse_value(Option& option, const Token& name)
+  {
+    if (option.get_type() == OptionType::OPTIONS)
+    {
+      parse_arguments(option.get_options());
+      return;
+    }
+
+    std::vector<Token> parts;
+
+    for (;;)
+    {
+      const Token token = lexer.next();
+
+      if (token.is(')'))
+      {
+        break;
+      }
+
+      if (token.type == Token::WORD || token.type == Token::STRING)
+      {
+        parts.push_back(token);
+      }
+      else if (!token.is(','))
+      {
+        error(token, token.type == Token::END ? "unexpected end of the file" : "unexpected " + std::string(token.text) + " in " + std::string(name.text));
+      }
+    }
+
+    if (parts.empty())
+    {
+      error(name, "missing value of " + std::string(name.text));
+    }
+
+    set_value(option, parts);
+  }
+
+  void set_value(Option& option, const std::vector<Token>& parts)
+  {
+    std::string value;
+
+    switch (option.get_type())
+    {
+      case OptionType::SET:
+      {
+        // the same separators as the dialog
+        static const Atom scope("scope");
+        const char* separator = option.get_schema().name == scope ? " " : ", ";
+
+        for (const Token& part : parts)
+        {
+          value += (value.empty() ? "" : separator);
+          value += part.text;
+        }
+        break;
+      }
+      case OptionType::STRING:
+        // adjacent strings are concatenated
+        for (const Token& part : parts)
+        {
+          append_string(value, part);
+        }
+        break;
+      case OptionType::NUMBER:
+      case OptionType::LIST:
+      {
+        if (parts.size() > 1)
+        {
+          error(parts[1], "more than one value of " + option.get_name());
+        }
+
+        value = std::string(parts.front().text);
+
+        if (option.get_type() == OptionType::NUMBER)
+        {
+          int number = 0;
+          const std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(), number);
+          if (result.ec != std::errc() || result.ptr != value.data() + value.size())
+          {
+            error(parts.front(), "invalid number of " + option.get_name() + ": " + value);
+          }
+        }
+        else
+        {
+          const std::vector<Atom>& values = option.get_schema().values;
+          if (std::none_of(values.begin(), values.end(), [&value](const Atom& atom) { return atom.str() == value; }))
+          {
+            error(parts.front(), "invalid value of " + option.get_name() + ": " + value);
+          }
+        }
+        break;
+      }
+      case OptionType::OPTIONS:
+        return;
+    }
+
+    option.set_current(value);
+  }
+
+  /*
+   * The values are written back between double quotes with their escape sequences kept.
+   * A single quoted string has no escape sequences, its backslashes and double quotes are escaped.
+   */
+  static void append_string(std::string& value, const Token& token)
+  {
+    if (token.quote != '\'')
+    {
+      value += token.text;
+      return;
+    }
+
+    for (const char c : token.text)
+    {
+      if (c == '\\' || c == '"')
+      {
+        value += '\\';
+      }
+      value += c;
+    }
+  }
+
+  Option& find_option(Object& object, const Token& name)
+  {
+    const std::string normalized = normalize(name.text);
+
+    OptionVector& options = object.get_options();
+    auto option = std::find_if(options.begin(), options.end(), [&normalized](const Option& option) {
+      return option.get_name() == normalized;
+    });
+
+    if (option == options.end())
+    {
+      error(name, "unknown option of " + object.get_name() + ": " + std::string(name.text));
+    }
+
+    return *option;
+  }
+
+  void parse_log_statement()
+  {
+    expect('{');
+
+    const std::size_t index = importer.log_statements.size();
+    importer.log_statements.push_back(config.add_log_statement());
+    LogStatement& log_statement = *importer.log_statements.back();
+
+    while (!lexer.peek().is('}'))
+    {
+      const Token name = expect_name();
+
+      if (lexer.peek().is('{'))
+      {
+        error(name, "embedded statements are not supported");
+      }
+
+      if (name.type == Token::WORD && contains(log_member_types, name.text))
+      {
+        expect('(');
+        const Token id = expect_name();
+        expect(')');
+        importer.log_members.push_back(Importer::LogMember{index, std::string(name.text), std::string(id.text), location(id)});
+      }
+      else if (name.is("log") || name.is("junction") || name.is("channel"))
+      {
+        error(name, std::string(name.text) + " in a log statement is not supported");
+      }
+      else
+      {
+        expect('(');
+        parse_value(find_option(log_statement.get_options(), name), name);
+      }
+
+      expect(';');
+    }
+
+    expect('}');
+    expect(';');
+  }
+};
+
+
+Importer::Importer(Config& config) :
+  config(config)
+{}
+
+void Importer::import_file(const std::string& file_name)
+{
+  read_file(file_name);
+  resolve_log_members();
+}
+
+void Importer::import_text(std::string_view text, const std::string& file_name)
+{
+  parse(text, file_name);
+  resolve_log_members();
+}
+
+const std::vector< std::shared_ptr<ObjectStatement> >& Importer::get_object_statements() const
+{
+  return object_statements;
+}
+
+const std::vector< std::shared_ptr<LogStatement> >& Importer::get_log_statements() const
+{
+  return log_statements;
+}
+
+const std::vector<std::string>& Importer::get_unresolved_includes() const
+{
+  return unresolved_includes;
+}
+
+void Importer::read_file(const std::string& file_name)
+{
+  QFile file(QString::fromStdString(file_name));
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    throw std::runtime_error(file_name + ": can't open the file");
+  }
+
+  const qint64 size = file.size();
+  if (size == 0)
+  {
+    return;
+  }
+
+  // parsed straight from the mapped file, read only if it can't be mapped
+  const char* map = reinterpret_cast<const char*>(file.map(0, size));
+  if (map)
+  {
+    parse(std::string_view(map, size), file_name);
+  }
+  else
+  {
+    const QByteArray data = file.readAll();
+    parse(std::string_view(data.constData(), data.size()), file_name);
+  }
+}
+
+void Importer::parse(std::string_view text, const std::string& file_name)
+{
+  ConfigParser(*this, text, file_name).parse();
+}
+
+void Importer::include(const std::string& pattern, const std::string& file_name)
+{
+  if (include_depth == 16)
+  {
+    throw std::runtime_error(file_name + ": @include nested too deep");
+  }
+
+  // relative to the including file, a directory means its files, the file name can have wildcards
+  const QFileInfo info(QDir(QFileInfo(QString::fromStdString(file_name)).absolutePath()).filePath(QString::fromStdString(pattern)));
+
+  QFileInfoList files;
+  if (info.isDir())
+  {
+    files = QDir(info.filePath()).entryInfoList(QDir::Files, QDir::Name);
+  }
+  else if (info.fileName().contains('*') || info.fileName().contains('?'))
+  {
+    files = QDir(info.absolutePath()).entryInfoList(QStringList(info.fileName()), QDir::Files, QDir::Name);
+  }
+  else if (info.isFile())
+  {
+    files.append(info);
+  }
+
+  if (files.isEmpty())
+  {
+    unresolved_includes.push_back(pattern);
+    return;
+  }
+
+  include_depth++;
+
+  try
+  {
+    for (const QFileInfo& file : files)
+    {
+      read_file(file.filePath().toStdString());
+    }
+  }
+  catch (...)
+  {
+    include_depth--;
+    throw;
+  }
+
+  include_depth--;
+}
+
+void Importer::resolve_log_members()
+{
+  for (const LogMember& member : log_members)
+  {
+    auto id = ids.find(member.id);
+    if (id == ids.end())
+    {
+      throw std::runtime_error(member.location + ": unknown statement: " + member.id);
+    }
+
+    const std::shared_ptr<ObjectStatement>& object_statement = object_statements[id->second];
+    if (object_statement->get_type() != member.type)
+    {
+      throw std::runtime_error(member.location + ": " + member.id + " is " +
+                               (object_statement->get_type().empty() ? "empty" : "a " + object_statement->get_type()) +
+                               ", not a " + member.type);
+    }
+
+    LogStatement& log_statement = *log_statements[member.log_statement];
+    log_statement.add_object_statement(object_statement, log_statement.get_object_statements().size());
+  }
+
+  log_members.clear();
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef IMPORTER_H
+#define IMPORTER_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Config;
+class ObjectStatement;
+class LogStatement;
+
+/*
+ * Reads syslog-ng configuration files into a Config, the inverse of Config::to_string.
+ * The drivers and their options are matched by name against the default Objects of the Config.
+ * The statements are held by the Importer, they are removed from the Config when it is destroyed.
+ *
+ * Not supported: blocks, junctions, embedded statements and parenthesized filter expressions,
+ * as the model has no place for them. Throws std::runtime_error with the file and line of the error.
+ */
+class Importer
+{
+  Config& config;
+
+  std::vector< std::shared_ptr<ObjectStatement> > object_statements;
+  std::vector< std::shared_ptr<LogStatement> > log_statements;
+
+  // ID -> index in object_statements
+  std::unordered_map<std::string, std::size_t> ids;
+
+  // a member of a log statement, resolved when the whole file is read, as it can come before the statement
+  struct LogMember
+  {
+    std::size_t log_statement;
+    std::string type;
+    std::string id;
+    std::string location;
+  };
+  std::vector<LogMember> log_members;
+
+  std::vector<std::string> unresolved_includes;
+  int include_depth = 0;
+
+public:
+  explicit Importer(Config& config);
+
+  void import_file(const std::string& file_name);
+
+  /*
+   * @file_name: only used in error messages and to find the included files.
+   */
+  void import_text(std::string_view text, const std::string& file_name);
+
+  const std::vector< std::shared_ptr<ObjectStatement> >& get_object_statements() const;
+  const std::vector< std::shared_ptr<LogStatement> >& get_log_statements() const;
+
+  /*
+   * @return: returns the included files that were not found next to the including file,
+   * like scl.conf, which is in the include path of syslog-ng.
+   */
+  const std::vector<std::string>& get_unresolved_includes() const;
+
+private:
+  friend class ConfigParser;
+
+  void read_file(const std::string& file_name);
+  void parse(std::string_view text, const std::string& file_name);
+  void include(const std::string& pattern, const std::string& file_name);
+  void resolve_log_members();
+};
+
+#endif  // IMPORTER_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef INDEXEDVECTOR_H
+#define INDEXEDVECTOR_H
+
+#include "arena.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Ordered, contiguous sequence of distinct shared_ptrs,
+ * with an index from each element to its position.
+ * Positional access and finding an element are O(1), inserting, erasing and moving
+ * shift the elements in between and update their positions.
+ */
+template<typename T>
+class IndexedVector
+{
+  typedef const typename T::element_type* Key;
+
+  std::vector< T, ArenaAllocator<T> > elements;
+  std::unordered_map< Key, std::size_t, std::hash<Key>, std::equal_to<Key>, ArenaAllocator< std::pair<const Key, std::size_t> > > positions;
+
+public:
+  typedef typename std::vector< T, ArenaAllocator<T> >::const_iterator const_iterator;
+
+  explicit IndexedVector(const std::shared_ptr<Arena>& arena) :
+    elements(ArenaAllocator<T>(arena)),
+    positions(ArenaAllocator< std::pair<const Key, std::size_t> >(arena))
+  {}
+
+  const_iterator begin() const { return elements.cbegin(); }
+  const_iterator end() const { return elements.cend(); }
+  std::size_t size() const { return elements.size(); }
+  bool empty() const { return elements.empty(); }
+  const T& operator[](std::size_t position) const { return elements[position]; }
+
+  bool contains(const T& element) const
+  {
+    return positions.count(element.get()) != 0;
+  }
+
+  /*
+   * @return: returns the position of @element, size() if it's not there.
+   */
+  std::size_t find(const T& element) const
+  {
+    auto it = positions.find(element.get());
+    return it == positions.end() ? elements.size() : it->second;
+  }
+
+  /*
+   * Insert @element before @position, or at the end if @position is past it.
+   * @return: returns false if @element is already there.
+   */
+  bool insert(const T& element, std::size_t position)
+  {
+    if (contains(element))
+    {
+      return false;
+    }
+
+    position = std::min(position, elements.size());
+    elements.insert(elements.begin() + position, element);
+    update_positions(position, elements.size());
+
+    return true;
+  }
+
+  /*
+   * @return: returns false if @element is not there.
+   */
+  bool erase(const T& element)
+  {
+    auto it = positions.find(element.get());
+    if (it == positions.end())
+    {
+      return false;
+    }
+
+    const std::size_t position = it->second;
+    positions.erase(it);
+    elements.erase(elements.begin() + position);
+    update_positions(position, elements.size());
+
+    return true;
+  }
+
+  /*
+   * Move @element to @position, or to the end if @position is past it, keeping the order of the others.
+   * @return: returns false if @element is not there, or is already at @position.
+   */
+  bool move(const T& element, std::size_t position)
+  {
+    auto it = positions.find(element.get());
+    if (it == positions.end())
+    {
+      return false;
+    }
+
+    const std::size_t from = it->second;
+    const std::size_t to = std::min(position, elements.size() - 1);
+
+    if (from < to)
+    {
+      std::rotate(elements.begin() + from, elements.begin() + from + 1, elements.begin() + to + 1);
+      update_positions(from, to + 1);
+    }
+    else if (to < from)
+    {
+      std::rotate(elements.begin() + to, elements.begin() + from, elements.begin() + from + 1);
+      update_positions(to, from + 1);
+    }
+
+    return from != to;
+  }
+
+private:
+  void update_positions(std::size_t first, std::size_t last)
+  {
+    for (std::size_t i = first; i < last; i++)
+    {
+      positions[elements[i].get()] = i;
+    }
+  }
+};
+
+#endif  // INDEXEDVECTOR_H
@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "linter.h"
+#include "config.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+  std::string locate(const ObjectStatement& object_statement)
+  {
+    return object_statement.get_type() + ' ' + object_statement.get_id();
+  }
+
+  std::string locate(const ObjectStatement& object_statement, const std::size_t position)
+  {
+    return locate(object_statement) + ", object " + std::to_string(position + 1);
+  }
+
+  std::string locate(const std::size_t log_number)
+  {
+    return "log #" + std::to_string(log_number);
+  }
+
+  /*
+   * @return: true if @flag is set in the flags of the log @options, a list or a set of values.
+   */
+  bool has_flag(const Options& options, const Atom& flag)
+  {
+    static const Atom flags("flags");
+
+    for (const Option& option : options.get_options())
+    {
+      if (option.get_schema().name != flags)
+      {
+        continue;
+      }
+
+      if (option.get_type() == OptionType::LIST)
+      {
+        const int current_value = std::get<ListValues>(option.get_values()).current_value;
+        return current_value >= 0 && option.get_schema().values.at(current_value) == flag;
+      }
+
+      if (option.get_type() == OptionType::SET)
+      {
+        const std::string& current_value = std::get<SetValues>(option.get_values()).current_value;
+        for (std::size_t begin = 0; begin < current_value.size(); begin++)
+        {
+          const std::size_t end = std::min(current_value.find_first_of(", ", begin), current_value.size());
+          if (std::string_view(current_value.data() + begin, end - begin) == flag.str())
+          {
+            return true;
+          }
+
+          begin = end;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void check_unused_statements(const Config& config, std::vector<LintDiagnostic>& diagnostics)
+  {
+    const StatementIndex& index = config.get_index();
+
+    for (const ObjectStatement& object_statement : config.get_object_statements())
+    {
+      // templates are referred to by options, the other statements by LogStatements, empty ones are not written
+      if (object_statement.get_objects().empty() || object_statement.get_type() == "template" ||
+          index.count_log_statements(object_statement) != 0)
+      {
+        continue;
+      }
+
+      diagnostics.push_back({ LintCheck::UNUSED_STATEMENT, &object_statement, nullptr, 0, locate(object_statement),
+                              "is not used in any log path" });
+    }
+  }
+
+  void check_empty_logs(const Config& config, std::vector<LintDiagnostic>& diagnostics)
+  {
+    static const Atom catchall("catchall");
+
+    std::size_t log_number = 0;
+    for (const LogStatement& log_statement : config.get_log_statements())
+    {
+      log_number++;
+
+      if (log_statement.get_object_statements().empty())
+      {
+        diagnostics.push_back({ LintCheck::EMPTY_LOG, nullptr, &log_statement, 0, locate(log_number), "is empty" });
+        continue;
+      }
+
+      bool has_source = false;
+      for (const std::shared_ptr<const ObjectStatement>& object_statement : log_statement.get_object_statements())
+      {
+        has_source = has_source || object_statement->get_type() == "source";
+      }
+
+      if (!has_source && !has_flag(log_statement.get_options(), catchall))
+      {
+        diagnostics.push_back({ LintCheck::EMPTY_LOG, nullptr, &log_statement, 0, locate(log_number),
+                                "has no source and no catchall flag, it never receives messages" });
+      }
+    }
+  }
+
+  /*
+   * "and" binds stronger than "or", a filter statement is a disjunction of conjunctions of filter functions.
+   * A conjunction never matches if it requires a filter function and its negation as well,
+   * the filter never matches if none of its conjunctions can.
+   * The filter functions are compared by their rendered text, which is cached by the Objects.
+   */
+  void check_filters(const Config& config, std::vector<LintDiagnostic>& diagnostics)
+  {
+    enum Polarity : unsigned int { PLAIN = 1 << 0, INVERTED = 1 << 1 };
+
+    struct Occurrence
+    {
+      std::size_t conjunction;  // the last conjunction the filter function occurred in
+      unsigned int polarities;
+    };
+
+    // numbered across all the filter statements, so the map is never cleared
+    std::unordered_map<std::string_view, Occurrence> occurrences;
+    std::size_t conjunction = 0;
+
+    for (const ObjectStatement& object_statement : config.get_object_statements())
+    {
+      const auto& objects = object_statement.get_objects();
+      if (object_statement.get_type() != "filter" || objects.empty())
+      {
+        continue;
+      }
+
+      conjunction++;
+      bool matches = false;
+      bool contradicts = false;
+      std::size_t contradiction = SIZE_MAX;  // the position of the first contradicting filter function
+
+      for (std::size_t i = 0; i < objects.size(); i++)
+      {
+        const Filter& filter = static_cast<const Filter&>(*objects[i]);
+
+        // "[not ]name(options) next", see Filter::render
+        std::string_view function = filter.to_string();
+        function.remove_prefix(filter.get_invert() ? 4 : 0);
+        function.remove_suffix(filter.get_next().size() + 1);
+
+        Occurrence& occurrence = occurrences[function];
+        if (occurrence.conjunction != conjunction)
+        {
+          occurrence = { conjunction, 0 };
+        }
+
+        occurrence.polarities |= filter.get_invert() ? INVERTED : PLAIN;
+        if (occurrence.polarities == (PLAIN | INVERTED))
+        {
+          contradicts = true;
+          contradiction = std::min(contradiction, i);
+        }
+
+        if (filter.get_next() == "or" || i == objects.size() - 1)
+        {
+          matches = matches || !contradicts;
+          contradicts = false;
+          conjunction++;
+        }
+      }
+
+      if (!matches)
+      {
+        diagnostics.push_back({ LintCheck::UNMATCHABLE_FILTER, &object_statement, nullptr, contradiction,
+                                locate(object_statement, contradiction),
+                                "never matches, every alternative requires a filter function and its negation" });
+      }
+    }
+  }
+
+  void check_duplicate_files(const Config& config, std::vector<LintDiagnostic>& diagnostics)
+  {
+    static const Atom file("file");
+
+    // path -> the first file destination writing it
+    std::unordered_map<std::string_view, std::pair<const ObjectStatement*, std::size_t> > writers;
+
+    for (const ObjectStatement& object_statement : config.get_object_statements())
+    {
+      if (object_statement.get_type() != "destination")
+      {
+        continue;
+      }
+
+      const auto& objects = object_statement.get_objects();
+      for (std::size_t i = 0; i < objects.size(); i++)
+      {
+        if (objects[i]->get_schema().name != file)
+        {
+          continue;
+        }
+
+        for (const Option& option : objects[i]->get_options())
+        {
+          if (option.get_schema().name != file || option.get_type() != OptionType::STRING)
+          {
+            continue;
+          }
+
+          const std::string& path = std::get<StringValues>(option.get_values()).current_value;
+          if (path.empty())
+          {
+            continue;
+          }
+
+          auto writer = writers.emplace(path, std::make_pair(&object_statement, i));
+          if (!writer.second)
+          {
+            diagnostics.push_back({ LintCheck::DUPLICATE_FILE, &object_statement, nullptr, i, locate(object_statement, i),
+                                    "writes \"" + path + "\" like " + locate(*writer.first->second.first, writer.first->second.second) });
+          }
+        }
+      }
+    }
+  }
+
+  /*
+   * The log paths are processed in order, a message processed by a path with the final flag
+   * is not sent to the later ones. Without filters and parsers, which can drop messages,
+   * a final path takes every message of its sources, or of all sources with the catchall flag,
+   * a later path only receiving from those sources gets nothing.
+   * The fallback paths only get the messages no other path processed, they are left out.
+   */
+  void check_shadowed_logs(const Config& config, std::vector<LintDiagnostic>& diagnostics)
+  {
+    static const Atom final_flag("final"), catchall("catchall"), fallback("fallback");
+
+    // source -> the number of the first final log path taking all of its messages
+    std::unordered_map<const ObjectStatement*, std::size_t> taken;
+    std::size_t catchall_taken = 0;
+
+    std::size_t log_number = 0;
+    for (const LogStatement& log_statement : config.get_log_statements())
+    {
+      log_number++;
+
+      const Options& options = log_statement.get_options();
+      if (has_flag(options, fallback))
+      {
+        continue;
+      }
+
+      bool is_filtered = false;
+      std::size_t n_sources = 0;
+      std::size_t n_taken = 0;
+      std::size_t shadowing = 0;  // the number of the final log path taking the messages
+
+      for (const std::shared_ptr<const ObjectStatement>& object_statement : log_statement.get_object_statements())
+      {
+        const std::string& type = object_statement->get_type();
+        is_filtered = is_filtered || type == "filter" || type == "parser";
+
+        if (type != "source")
+        {
+          continue;
+        }
+
+        n_sources++;
+        auto source = taken.find(object_statement.get());
+        if (source != taken.end())
+        {
+          n_taken++;
+          shadowing = source->second;
+        }
+      }
+
+      // a path without sources and catchall flag is reported by check_empty_logs
+      const bool is_catchall = has_flag(options, catchall);
+      if (catchall_taken != 0 && (is_catchall || n_sources != 0))
+      {
+        shadowing = catchall_taken;
+      }
+      else if (is_catchall || n_sources == 0 || n_taken != n_sources)
+      {
+        shadowing = 0;
+      }
+
+      if (shadowing != 0)
+      {
+        diagnostics.push_back({ LintCheck::SHADOWED_LOG, nullptr, &log_statement, 0, locate(log_number),
+                                "never receives messages, the final flag of " + locate(shadowing) + " takes them" });
+        continue;
+      }
+
+      if (is_filtered || !has_flag(options, final_flag))
+      {
+        continue;
+      }
+
+      if (is_catchall)
+      {
+        catchall_taken = log_number;
+        continue;
+      }
+
+      for (const std::shared_ptr<const ObjectStatement>& object_statement : log_statement.get_object_statements())
+      {
+        if (object_statement->get_type() == "source")
+        {
+          taken.emplace(object_statement.get(), log_number);
+        }
+      }
+    }
+  }
+}
+
+std::vector<LintDiagnostic> lint(const Config& config)
+{
+  std::vector<LintDiagnostic> diagnostics;
+
+  check_unused_statements(config, diagnostics);
+  check_empty_logs(config, diagnostics);
+  check_filters(config, diagnostics);
+  check_duplicate_files(config, diagnostics);
+  check_shadowed_logs(config, diagnostics);
+
+  return diagnostics;
+}
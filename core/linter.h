@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef LINTER_H
+#define LINTER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Config;
+class ObjectStatement;
+class LogStatement;
+
+enum class LintCheck { UNUSED_STATEMENT, EMPTY_LOG, UNMATCHABLE_FILTER, DUPLICATE_FILE, SHADOWED_LOG };
+
+/*
+ * A mistake that syslog-ng accepts, but is most likely not intended.
+ * The configuration has no lines, the location is the statement
+ * and the position of the Object in it, like in the written configuration.
+ */
+struct LintDiagnostic
+{
+  LintCheck check;
+  const ObjectStatement* object_statement;  // nullptr for a LogStatement
+  const LogStatement* log_statement;  // nullptr for an ObjectStatement
+  std::size_t position;  // index in the Objects of @object_statement, 0 for a whole statement
+  std::string location;  // e.g. "filter f_auth, object 2" or "log #3", the logs are numbered in order from 1
+  std::string message;
+};
+
+/*
+ * Finds the unused ObjectStatements, the empty LogStatements, the filters that can never match,
+ * the file destinations writing the same file and the LogStatements shadowed by an earlier final one.
+ * Runs in time linear in the size of the configuration, the references are counted by the StatementIndex.
+ * Only reads @config, the diagnostics are ordered by check.
+ */
+std::vector<LintDiagnostic> lint(const Config& config);
+
+#endif  // LINTER_H
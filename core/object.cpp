@@ -0,0 +1,725 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "object.h"
+#include "statementindex.h"
+#include "sink.h"
+
+#include <cstring>
+
+namespace
+{
+  const Object& substitute(const Object& object, const Substitutions* substitutions)
+  {
+    if (substitutions)
+    {
+      auto it = substitutions->find(&object);
+      if (it != substitutions->end())
+      {
+        return *it->second;
+      }
+    }
+
+    return object;
+  }
+}
+
+Object::Object(std::shared_ptr<const ObjectSchema> schema) :
+  schema(std::move(schema))
+{
+  options.reserve(this->schema->options.size());
+}
+
+Object::Object(const Object& other) :
+  schema(other.schema),
+  options(other.options),
+  generation(other.generation),
+  cache(other.cache),
+  cache_generation(other.cache_generation)
+{
+  track_options();
+}
+
+Object::Object(const Object& other, const std::shared_ptr<Arena>& arena) :
+  schema(other.schema),
+  options(other.options, ArenaAllocator<Option>(arena)),
+  generation(other.generation),
+  cache(other.cache),
+  cache_generation(other.cache_generation)
+{
+  track_options();
+}
+
+const std::string& Object::get_name() const
+{
+  return schema->name.str();
+}
+
+const std::string& Object::get_description() const
+{
+  return schema->description;
+}
+
+const ObjectSchema& Object::get_schema() const
+{
+  return *schema;
+}
+
+OptionVector& Object::get_options()
+{
+  return options;
+}
+
+const OptionVector& Object::get_options() const
+{
+  return options;
+}
+
+void Object::add_option(Option option)
+{
+  options.push_back(std::move(option));
+  options.back().set_generation(&generation);
+}
+
+Generation& Object::get_generation() const
+{
+  return generation;
+}
+
+void Object::track_options()
+{
+  for (Option& option : options)
+  {
+    option.set_generation(&generation);
+  }
+}
+
+const char* Object::get_separator() const
+{
+  return "";
+}
+
+const std::string& Object::to_string() const
+{
+  if (cache_generation != generation.get())
+  {
+    cache.clear();
+    StringSink sink(cache);
+    render(sink);
+    cache_generation = generation.get();
+  }
+
+  return cache;
+}
+
+void Object::write(Sink& sink) const
+{
+  sink << to_string();
+}
+
+void Object::render(Sink& sink) const
+{
+  render_call(sink);
+  sink << ';';
+}
+
+void Object::render_call(Sink& sink) const
+{
+  const char* separator = get_separator();
+  const bool trailing_separator = std::strcmp(separator, ",") != 0;
+  bool first = true;
+
+  sink << get_name() << '(';
+
+  for (const Option& option : options)
+  {
+    const bool unnamed = schema->name == option.get_schema().name;
+    if (!unnamed && !option.has_changed())
+    {
+      continue;
+    }
+
+    // the separator goes between the options, and after the last one too unless it is a comma
+    if (!first)
+    {
+      sink << separator;
+    }
+    first = false;
+
+    if (unnamed)
+    {
+      option.write_value(sink);
+      continue;
+    }
+
+    sink << "\n        ";
+    option.write(sink);
+  }
+
+  if (!first && trailing_separator)
+  {
+    sink << separator;
+  }
+
+  sink << ')';
+}
+
+
+template<class Derived>
+ObjectBase<Derived>::ObjectBase(std::shared_ptr<const ObjectSchema> schema) :
+  Object(std::move(schema))
+{}
+
+template<class Derived>
+ObjectBase<Derived>::ObjectBase(const ObjectBase& other, const std::shared_ptr<Arena>& arena) :
+  Object(other, arena)
+{}
+
+template<class Derived>
+Object* ObjectBase<Derived>::clone() const
+{
+  return new Derived(static_cast<const Derived&>(*this));
+}
+
+template<class Derived>
+std::shared_ptr<Object> ObjectBase<Derived>::clone(const std::shared_ptr<Arena>& arena) const
+{
+  return std::allocate_shared<Derived>(ArenaAllocator<Derived>(arena), static_cast<const Derived&>(*this), arena);
+}
+
+Source::Source(std::shared_ptr<const ObjectSchema> schema) :
+  ObjectBase<Source>(std::move(schema))
+{}
+
+Source::Source(const Source& other, const std::shared_ptr<Arena>& arena) :
+  ObjectBase<Source>(other, arena)
+{}
+
+const std::string& Source::get_type() const
+{
+  static const std::string type = "source";
+  return type;
+}
+
+
+Destination::Destination(std::shared_ptr<const ObjectSchema> schema) :
+  ObjectBase<Destination>(std::move(schema))
+{}
+
+Destination::Destination(const Destination& other, const std::shared_ptr<Arena>& arena) :
+  ObjectBase<Destination>(other, arena)
+{}
+
+const std::string& Destination::get_type() const
+{
+  static const std::string type = "destination";
+  return type;
+}
+
+
+Filter::Filter(std::shared_ptr<const ObjectSchema> schema) :
+  ObjectBase<Filter>(std::move(schema))
+{}
+
+Filter::Filter(const Filter& other, const std::shared_ptr<Arena>& arena) :
+  ObjectBase<Filter>(other, arena),
+  invert(other.invert),
+  next(other.next)
+{}
+
+bool Filter::get_invert() const
+{
+  return invert;
+}
+
+const std::string& Filter::get_next() const
+{
+  return next;
+}
+
+void Filter::set_invert(bool invert)
+{
+  if (this->invert != invert)
+  {
+    generation.bump();
+  }
+
+  this->invert = invert;
+}
+
+void Filter::set_next(const std::string& next)
+{
+  if (this->next != next)
+  {
+    generation.bump();
+  }
+
+  this->next = next;
+}
+
+const std::string& Filter::get_type() const
+{
+  static const std::string type = "filter";
+  return type;
+}
+
+void Filter::render(Sink& sink) const
+{
+  if (invert)
+  {
+    sink << "not ";
+  }
+
+  render_call(sink);
+  sink << ' ' << next;
+}
+
+
+Template::Template(std::shared_ptr<const ObjectSchema> schema) :
+  ObjectBase<Template>(std::move(schema))
+{}
+
+Template::Template(const Template& other, const std::shared_ptr<Arena>& arena) :
+  ObjectBase<Template>(other, arena)
+{}
+
+const std::string& Template::get_type() const
+{
+  static const std::string type = "template";
+  return type;
+}
+
+
+Rewrite::Rewrite(std::shared_ptr<const ObjectSchema> schema) :
+  ObjectBase<Rewrite>(std::move(schema))
+{}
+
+Rewrite::Rewrite(const Rewrite& other, const std::shared_ptr<Arena>& arena) :
+  ObjectBase<Rewrite>(other, arena)
+{}
+
+const std::string& Rewrite::get_type() const
+{
+  static const std::string type = "rewrite";
+  return type;
+}
+
+const char* Rewrite::get_separator() const
+{
+  return ",";
+}
+
+
+Parser::Parser(std::shared_ptr<const ObjectSchema> schema) :
+  ObjectBase<Parser>(std::move(schema))
+{}
+
+Parser::Parser(const Parser& other, const std::shared_ptr<Arena>& arena) :
+  ObjectBase<Parser>(other, arena)
+{}
+
+const std::string& Parser::get_type() const
+{
+  static const std::string type = "parser";
+  return type;
+}
+
+
+Options::Options(std::shared_ptr<const ObjectSchema> schema) :
+  ObjectBase<Options>(std::move(schema))
+{}
+
+Options::Options(const Options& other, const std::shared_ptr<Arena>& arena) :
+  ObjectBase<Options>(other, arena),
+  separator(other.separator)
+{}
+
+void Options::set_separator(const std::string& separator)
+{
+  if (this->separator != separator)
+  {
+    generation.bump();
+  }
+
+  this->separator = separator;
+}
+
+const std::string& Options::get_type() const
+{
+  static const std::string type = "options";
+  return type;
+}
+
+void Options::render(Sink& sink) const
+{
+  for (const Option& option : options)
+  {
+    if (!option.has_changed())
+    {
+      continue;
+    }
+
+    sink << "\n    ";
+    option.write(sink);
+    sink << separator;
+  }
+}
+
+
+GlobalOptions::GlobalOptions(const Options& options, Generation* parent) :
+  options(options)
+{
+  this->options.set_separator(";");
+  this->options.get_generation().set_parent(parent);
+}
+
+Options& GlobalOptions::get_options()
+{
+  return options;
+}
+
+const Options& GlobalOptions::get_options() const
+{
+  return options;
+}
+
+void GlobalOptions::write(Sink& sink, const Substitutions* substitutions) const
+{
+  const Object& options = substitute(this->options, substitutions);
+
+  if (!has_changed(options))
+  {
+    return;
+  }
+
+  sink << "options {";
+
+  options.write(sink);
+
+  sink << "\n};\n\n";
+}
+
+bool GlobalOptions::has_changed(const Object& options)
+{
+  for (const Option& option : options.get_options())
+  {
+    if (option.has_changed())
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+ObjectStatement::ObjectStatement(const std::string& id, const std::shared_ptr<Arena>& arena, Generation* parent, StatementIndex* index) :
+  id(id),
+  objects(arena),
+  generation(parent),
+  index(index)
+{
+  index->add_object_statement(*this);
+}
+
+ObjectStatement::~ObjectStatement()
+{
+  // Objects still held elsewhere are detached, the Config may be destroyed before them
+  for (const std::shared_ptr<const Object>& object : objects)
+  {
+    index->unlink(*object, *this);
+    detach(*object);
+  }
+
+  index->remove_object_statement(*this);
+}
+
+const std::string& ObjectStatement::get_type() const
+{
+  return type;
+}
+
+std::uint64_t ObjectStatement::get_type_version() const
+{
+  return type_version;
+}
+
+const std::string& ObjectStatement::get_id() const
+{
+  return id;
+}
+
+const IndexedVector< std::shared_ptr<const Object> >& ObjectStatement::get_objects() const
+{
+  return objects;
+}
+
+void ObjectStatement::add_object(const std::shared_ptr<const Object>& object, const int position)
+{
+  if (objects.empty() && type != object->get_type())
+  {
+    type = object->get_type();
+    ++type_version;
+  }
+
+  if (objects.insert(object, position))
+  {
+    object->get_generation().set_parent(&generation);
+    index->link(*object, *this);
+    generation.bump();
+  }
+}
+
+void ObjectStatement::remove_object(const std::shared_ptr<const Object>& object)
+{
+  if (objects.erase(object))
+  {
+    index->unlink(*object, *this);
+    detach(*object);
+    generation.bump();
+  }
+
+  if (objects.empty() && !type.empty())
+  {
+    type.clear();
+    ++type_version;
+  }
+}
+
+void ObjectStatement::detach(const Object& object) const
+{
+  const std::vector<const ObjectStatement*>& holders = index->get_object_statements(object);
+  object.get_generation().set_parent(holders.empty() ? nullptr : &holders.front()->generation);
+}
+
+void ObjectStatement::move_object(const std::shared_ptr<const Object>& object, const int position)
+{
+  if (objects.move(object, position))
+  {
+    generation.bump();
+  }
+}
+
+void ObjectStatement::write(Sink& sink, const Substitutions* substitutions) const
+{
+  if (has_substitute(substitutions))
+  {
+    render(sink, substitutions);
+    return;
+  }
+
+  sink << to_string();
+}
+
+const std::string& ObjectStatement::to_string() const
+{
+  const std::uint64_t object_generations = get_object_generations();
+
+  if (cache_generation != generation.get() || cache_object_generations != object_generations)
+  {
+    cache.clear();
+    StringSink sink(cache);
+    render(sink, nullptr);
+    cache_generation = generation.get();
+    cache_object_generations = object_generations;
+  }
+
+  return cache;
+}
+
+// the generations only increase, so their sum changes if any of them does
+std::uint64_t ObjectStatement::get_object_generations() const
+{
+  std::uint64_t object_generations = 0;
+
+  for (const std::shared_ptr<const Object>& object : objects)
+  {
+    object_generations += object->get_generation().get();
+  }
+
+  return object_generations;
+}
+
+bool ObjectStatement::has_substitute(const Substitutions* substitutions) const
+{
+  if (!substitutions)
+  {
+    return false;
+  }
+
+  for (const std::shared_ptr<const Object>& object : objects)
+  {
+    if (substitutions->count(object.get()))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ObjectStatement::render(Sink& sink, const Substitutions* substitutions) const
+{
+  if (objects.empty())
+  {
+    return;
+  }
+
+  sink << type << ' ' << id << " {";
+
+  // the last filter has no next, its trailing space is replaced by a semicolon
+  const Object* last_filter = type == "filter" ? objects[objects.size() - 1].get() : nullptr;
+
+  for (const std::shared_ptr<const Object>& object : objects)
+  {
+    sink << "\n    ";
+
+    if (object.get() == last_filter)
+    {
+      const std::string& filter = substitute(*object, substitutions).to_string();
+      sink.write(filter.data(), filter.size() - 1);
+      sink << ';';
+      continue;
+    }
+
+    substitute(*object, substitutions).write(sink);
+  }
+
+  sink << "\n};\n\n";
+}
+
+
+LogStatement::LogStatement(const Options& options, const std::shared_ptr<Arena>& arena, Generation* parent, StatementIndex* index) :
+  object_statements(arena),
+  options(options, arena),
+  generation(parent),
+  index(index)
+{
+  this->options.set_separator(";");
+  this->options.get_generation().set_parent(&generation);
+}
+
+LogStatement::~LogStatement()
+{
+  for (const std::shared_ptr<const ObjectStatement>& object_statement : object_statements)
+  {
+    index->unlink(*object_statement, *this);
+  }
+}
+
+const IndexedVector< std::shared_ptr<const ObjectStatement> >& LogStatement::get_object_statements() const
+{
+  return object_statements;
+}
+
+Options& LogStatement::get_options()
+{
+  return options;
+}
+
+const Options& LogStatement::get_options() const
+{
+  return options;
+}
+
+void LogStatement::add_object_statement(const std::shared_ptr<const ObjectStatement>& object_statement, const int position)
+{
+  if (object_statements.insert(object_statement, position))
+  {
+    index->link(*object_statement, *this);
+    generation.bump();
+  }
+}
+
+void LogStatement::remove_object_statement(const std::shared_ptr< const ObjectStatement >& object_statement)
+{
+  if (object_statements.erase(object_statement))
+  {
+    index->unlink(*object_statement, *this);
+    generation.bump();
+  }
+}
+
+void LogStatement::move_object_statement(const std::shared_ptr<const ObjectStatement>& object_statement, const int position)
+{
+  if (object_statements.move(object_statement, position))
+  {
+    generation.bump();
+  }
+}
+
+void LogStatement::write(Sink& sink, const Substitutions* substitutions) const
+{
+  if (substitutions && substitutions->count(&options))
+  {
+    render(sink, substitutions);
+    return;
+  }
+
+  sink << to_string();
+}
+
+const std::string& LogStatement::to_string() const
+{
+  const std::uint64_t type_versions = get_type_versions();
+
+  if (cache_generation != generation.get() || cache_type_versions != type_versions)
+  {
+    cache.clear();
+    StringSink sink(cache);
+    render(sink, nullptr);
+    cache_generation = generation.get();
+    cache_type_versions = type_versions;
+  }
+
+  return cache;
+}
+
+// the versions only increase, so their sum changes if any of them does
+std::uint64_t LogStatement::get_type_versions() const
+{
+  std::uint64_t type_versions = 0;
+
+  for (const std::shared_ptr<const ObjectStatement>& object_statement : object_statements)
+  {
+    type_versions += object_statement->get_type_version();
+  }
+
+  return type_versions;
+}
+
+void LogStatement::render(Sink& sink, const Substitutions* substitutions) const
+{
+  if (object_statements.empty())
+  {
+    return;
+  }
+
+  sink << "log {";
+
+  for (const std::shared_ptr<const ObjectStatement>& object_statement : object_statements)
+  {
+    sink << "\n    " << object_statement->get_type() << '(' << object_statement->get_id() << ");";
+  }
+
+  substitute(options, substitutions).write(sink);
+
+  sink << "\n};\n\n";
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef OBJECT_H
+#define OBJECT_H
+
+#include "option.h"
+#include "arena.h"
+#include "indexedvector.h"
+
+#include <unordered_map>
+
+class StatementIndex;
+
+typedef std::vector< Option, ArenaAllocator<Option> > OptionVector;
+
+/*
+ * Abstract base class for simple objects with options.
+ * The name and description are shared between all the copies of an object,
+ * the options are stored contiguously, by value.
+ */
+class Object
+{
+protected:
+  std::shared_ptr<const ObjectSchema> schema;
+  OptionVector options;
+
+  // counts the changes of the Object and its options, mutable for the ObjectStatement holding it as const
+  mutable Generation generation;
+
+private:
+  // output of to_string(), valid while @generation is at @cache_generation
+  mutable std::string cache;
+  mutable std::uint64_t cache_generation = UINT64_MAX;
+
+public:
+  explicit Object(std::shared_ptr<const ObjectSchema> schema);
+  Object(const Object& other);
+
+  /*
+   * Copy @other with its options allocated from @arena.
+   */
+  Object(const Object& other, const std::shared_ptr<Arena>& arena);
+  virtual ~Object() {}
+
+  virtual Object* clone() const = 0;
+
+  /*
+   * @return: returns a copy allocated from @arena, together with its shared_ptr control block.
+   */
+  virtual std::shared_ptr<Object> clone(const std::shared_ptr<Arena>& arena) const = 0;
+
+  const std::string& get_name() const;
+  const std::string& get_description() const;
+  const ObjectSchema& get_schema() const;
+  OptionVector& get_options();
+  const OptionVector& get_options() const;
+
+  void add_option(Option option);
+
+  /*
+   * The parent of the returned Generation is set by the container of the Object.
+   */
+  Generation& get_generation() const;
+
+
+  virtual const std::string& get_type() const = 0;
+  virtual const char* get_separator() const;
+
+  /*
+   * @return: returns the Object in syslog-ng syntax, rendered again only if it has changed since the last call.
+   */
+  const std::string& to_string() const;
+  void write(Sink& sink) const;
+
+protected:
+  virtual void render(Sink& sink) const;
+
+  // writes "name(options)" without the closing semicolon
+  void render_call(Sink& sink) const;
+
+private:
+  // points the options to @generation
+  void track_options();
+};
+
+template<class Derived>
+class ObjectBase : public Object
+{
+public:
+  explicit ObjectBase(std::shared_ptr<const ObjectSchema> schema);
+  ObjectBase(const ObjectBase& other) = default;
+  ObjectBase(const ObjectBase& other, const std::shared_ptr<Arena>& arena);
+
+  Object* clone() const;
+  std::shared_ptr<Object> clone(const std::shared_ptr<Arena>& arena) const;
+};
+
+class Source : public ObjectBase<Source>
+{
+public:
+  explicit Source(std::shared_ptr<const ObjectSchema> schema);
+  Source(const Source& other) = default;
+  Source(const Source& other, const std::shared_ptr<Arena>& arena);
+
+
+  const std::string& get_type() const;
+};
+
+class Destination : public ObjectBase<Destination>
+{
+public:
+  explicit Destination(std::shared_ptr<const ObjectSchema> schema);
+  Destination(const Destination& other) = default;
+  Destination(const Destination& other, const std::shared_ptr<Arena>& arena);
+
+
+  const std::string& get_type() const;
+};
+
+class Filter : public ObjectBase<Filter>
+{
+  bool invert = false;
+  std::string next;
+
+public:
+  explicit Filter(std::shared_ptr<const ObjectSchema> schema);
+  Filter(const Filter& other) = default;
+  Filter(const Filter& other, const std::shared_ptr<Arena>& arena);
+
+  bool get_invert() const;
+  const std::string& get_next() const;
+  void set_invert(bool invert);
+  void set_next(const std::string& next);
+
+
+  const std::string& get_type() const;
+
+protected:
+  void render(Sink& sink) const;
+};
+
+class Template : public ObjectBase<Template>
+{
+public:
+  explicit Template(std::shared_ptr<const ObjectSchema> schema);
+  Template(const Template& other) = default;
+  Template(const Template& other, const std::shared_ptr<Arena>& arena);
+
+
+  const std::string& get_type() const;
+};
+
+class Rewrite : public ObjectBase<Rewrite>
+{
+public:
+  explicit Rewrite(std::shared_ptr<const ObjectSchema> schema);
+  Rewrite(const Rewrite& other) = default;
+  Rewrite(const Rewrite& other, const std::shared_ptr<Arena>& arena);
+
+
+  const std::string& get_type() const;
+  const char* get_separator() const;
+};
+
+class Parser : public ObjectBase<Parser>
+{
+public:
+  explicit Parser(std::shared_ptr<const ObjectSchema> schema);
+  Parser(const Parser& other) = default;
+  Parser(const Parser& other, const std::shared_ptr<Arena>& arena);
+
+
+  const std::string& get_type() const;
+};
+
+/*
+ * Special class holding options for global options,
+ * log options, tls and value-pairs options.
+ * Doesn't have a visual representation.
+ */
+class Options : public ObjectBase<Options>
+{
+  std::string separator;
+
+public:
+  explicit Options(std::shared_ptr<const ObjectSchema> schema);
+  Options(const Options& other) = default;
+  Options(const Options& other, const std::shared_ptr<Arena>& arena);
+
+  void set_separator(const std::string& separator);
+
+
+  const std::string& get_type() const;
+
+protected:
+  void render(Sink& sink) const;
+};
+
+/*
+ * Objects written in place of others, like copies with different option values.
+ * Writing with substitutions only reads the Objects of the configuration,
+ * so it can run on multiple threads once their output is cached by a plain write.
+ */
+typedef std::unordered_map<const Object*, const Object*> Substitutions;
+
+class GlobalOptions
+{
+  Options options;
+
+public:
+  /*
+   * @parent: the Generation counting the changes of the global options.
+   */
+  GlobalOptions(const Options& options, Generation* parent);
+
+  Options& get_options();
+  const Options& get_options() const;
+
+  /*
+   * @substitutions: see Substitutions.
+   */
+  void write(Sink& sink, const Substitutions* substitutions = nullptr) const;
+
+private:
+  static bool has_changed(const Object& options);
+};
+
+/*
+ * Holds Objects.
+ */
+class ObjectStatement
+{
+  std::string type;
+  std::string id;
+  IndexedVector< std::shared_ptr<const Object> > objects;
+
+  // counts the changes of the ObjectStatement and its Objects,
+  // mutable for the other ObjectStatements holding the same Object, see detach
+  mutable Generation generation;
+
+  // incremented whenever @type changes, the LogStatements holding the ObjectStatement write its type
+  std::uint64_t type_version = 0;
+
+  // output of a write without substitutions, valid while @generation is at @cache_generation
+  // and the generations of the Objects still add up to @cache_object_generations,
+  // an Object held by several ObjectStatements counts only in one of them
+  mutable std::string cache;
+  mutable std::uint64_t cache_generation = UINT64_MAX;
+  mutable std::uint64_t cache_object_generations = 0;
+
+  StatementIndex* index;
+
+public:
+  /*
+   * @arena: the Objects are held in memory from @arena.
+   * @parent: the Generation counting the changes of the ObjectStatement.
+   * @index: the cross references of the configuration, updated as Objects are added and removed, has to outlive the ObjectStatement.
+   */
+  ObjectStatement(const std::string& id, const std::shared_ptr<Arena>& arena, Generation* parent, StatementIndex* index);
+  ~ObjectStatement();
+
+  const std::string& get_type() const;
+  std::uint64_t get_type_version() const;
+  const std::string& get_id() const;
+  const IndexedVector< std::shared_ptr<const Object> >& get_objects() const;
+
+  void add_object(const std::shared_ptr<const Object>& object, const int position);
+  void remove_object(const std::shared_ptr<const Object>& object);
+
+  /*
+   * Move @object to @position, the positions of the other Objects keep their order.
+   */
+  void move_object(const std::shared_ptr<const Object>& object, const int position);
+
+  /*
+   * Writes the ObjectStatement to @sink in syslog-ng syntax,
+   * it is rendered again only if it changed since the last call.
+   * @substitutions: see Substitutions.
+   */
+  void write(Sink& sink, const Substitutions* substitutions = nullptr) const;
+
+private:
+  const std::string& to_string() const;
+  void render(Sink& sink, const Substitutions* substitutions) const;
+  bool has_substitute(const Substitutions* substitutions) const;
+  std::uint64_t get_object_generations() const;
+
+  /*
+   * Points the Generation of @object, no longer held by this ObjectStatement,
+   * to another ObjectStatement holding it, or detaches it if there is none.
+   */
+  void detach(const Object& object) const;
+
+  // non copyable, the Objects point to @generation
+  ObjectStatement(const ObjectStatement&) = delete;
+  ObjectStatement& operator=(const ObjectStatement&) = delete;
+};
+
+/*
+ * Holds ObjectStatements, each one at most once.
+ */
+class LogStatement
+{
+  IndexedVector< std::shared_ptr<const ObjectStatement> > object_statements;
+  Options options;
+
+  // counts the changes of the LogStatement and its options
+  Generation generation;
+
+  // output of a write without substitutions, valid while @generation is at @cache_generation
+  // and the type versions of the ObjectStatements still add up to @cache_type_versions
+  mutable std::string cache;
+  mutable std::uint64_t cache_generation = UINT64_MAX;
+  mutable std::uint64_t cache_type_versions = 0;
+
+  StatementIndex* index;
+
+public:
+  /*
+   * @options: the log options, copied.
+   * @arena, @parent, @index: see ObjectStatement.
+   */
+  LogStatement(const Options& options, const std::shared_ptr<Arena>& arena, Generation* parent, StatementIndex* index);
+  ~LogStatement();
+
+  const IndexedVector< std::shared_ptr<const ObjectStatement> >& get_object_statements() const;
+  Options& get_options();
+  const Options& get_options() const;
+
+  /*
+   * Does nothing if @object_statement is already in the LogStatement.
+   */
+  void add_object_statement(const std::shared_ptr<const ObjectStatement>& object_statement, const int position);
+  void remove_object_statement(const std::shared_ptr<const ObjectStatement>& object_statement);
+
+  /*
+   * Move @object_statement to @position, the positions of the other ObjectStatements keep their order.
+   */
+  void move_object_statement(const std::shared_ptr<const ObjectStatement>& object_statement, const int position);
+
+  /*
+   * Writes the LogStatement to @sink in syslog-ng syntax,
+   * it is rendered again only if it or the type of one of its ObjectStatements changed since the last call.
+   * @substitutions: see Substitutions.
+   */
+  void write(Sink& sink, const Substitutions* substitutions = nullptr) const;
+
+private:
+  const std::string& to_string() const;
+  void render(Sink& sink, const Substitutions* substitutions) const;
+  std::uint64_t get_type_versions() const;
+
+  // non copyable, the options point to @generation
+  LogStatement(const LogStatement&) = delete;
+  LogStatement& operator=(const LogStatement&) = delete;
+};
+
+#endif  // OBJECT_H
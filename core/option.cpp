@@ -0,0 +1,412 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "option.h"
+#include "object.h"
+#include "sink.h"
+
+#include <algorithm>
+
+namespace
+{
+  // the same operation for every SimpleValues alternative, overloaded for ExternValues
+
+  template<typename Values>
+  bool is_changed(const Values& values, bool required)
+  {
+    return required || values.current_value != values.default_value;
+  }
+
+  bool is_changed(const ExternValues& values, bool)
+  {
+    for (const Option& option : values.options->get_options())
+    {
+      if (option.has_changed())
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  template<typename Values>
+  void save_previous(Values& values)
+  {
+    values.previous_value = values.current_value;
+  }
+
+  void save_previous(ExternValues& values)
+  {
+    for (Option& option : values.options->get_options())
+    {
+      option.set_previous();
+    }
+  }
+
+  /*
+   * @return: returns true if @value has changed.
+   */
+  template<typename Value>
+  bool assign(Value& value, const Value& new_value)
+  {
+    if (value == new_value)
+    {
+      return false;
+    }
+
+    value = new_value;
+    return true;
+  }
+
+  template<typename Values>
+  bool reset_to_default(Values& values)
+  {
+    return assign(values.current_value, values.default_value);
+  }
+
+  // the nested options count their own changes
+  bool reset_to_default(ExternValues& values)
+  {
+    for (Option& option : values.options->get_options())
+    {
+      option.restore_default();
+    }
+
+    return false;
+  }
+
+  template<typename Values>
+  bool reset_to_previous(Values& values)
+  {
+    return assign(values.current_value, values.previous_value);
+  }
+
+  bool reset_to_previous(ExternValues& values)
+  {
+    for (Option& option : values.options->get_options())
+    {
+      option.restore_previous();
+    }
+
+    return false;
+  }
+}
+
+
+ExternValues::ExternValues()
+{}
+
+ExternValues::ExternValues(const ExternValues& other) :
+  options(other.options ? std::make_unique<Options>(*other.options) : nullptr)
+{}
+
+ExternValues::ExternValues(ExternValues&& other) noexcept = default;
+
+ExternValues& ExternValues::operator=(const ExternValues& other)
+{
+  options = other.options ? std::make_unique<Options>(*other.options) : nullptr;
+  return *this;
+}
+
+ExternValues& ExternValues::operator=(ExternValues&& other) noexcept = default;
+
+ExternValues::~ExternValues()
+{}
+
+
+Option::Option(std::shared_ptr<const OptionSchema> schema, OptionType type) :
+  schema(std::move(schema))
+{
+  switch (type)
+  {
+    case OptionType::STRING:
+      values.emplace<StringValues>();
+      break;
+    case OptionType::NUMBER:
+      values.emplace<NumberValues>(NumberValues{-1, -1, -1});
+      break;
+    case OptionType::LIST:
+      values.emplace<ListValues>(ListValues{-1, -1, -1});
+      break;
+    case OptionType::SET:
+      values.emplace<SetValues>();
+      break;
+    case OptionType::OPTIONS:
+      values.emplace<ExternValues>();
+      break;
+  }
+}
+
+OptionType Option::get_type() const
+{
+  return static_cast<OptionType>(values.index());
+}
+
+const std::string& Option::get_name() const
+{
+  return schema->name.str();
+}
+
+const std::string& Option::get_description() const
+{
+  return schema->description;
+}
+
+const OptionSchema& Option::get_schema() const
+{
+  return *schema;
+}
+
+const Option::Values& Option::get_values() const
+{
+  return values;
+}
+
+const std::string Option::get_current_value() const
+{
+  std::string value;
+  StringSink sink(value);
+  write_value(sink);
+
+  return value;
+}
+
+void Option::write_value(Sink& sink) const
+{
+  switch (get_type())
+  {
+    case OptionType::STRING:
+    {
+      const std::string& current_value = std::get<StringValues>(values).current_value;
+
+      // should be NumberOption, but spinbox wouldn't be suitable
+      static const Atom perm("perm"), dir_perm("dir-perm");
+      if (schema->name == perm || schema->name == dir_perm)
+      {
+        sink << current_value;
+        return;
+      }
+
+      sink << '"' << current_value << '"';
+      return;
+    }
+    case OptionType::NUMBER:
+      sink << std::get<NumberValues>(values).current_value;
+      return;
+    case OptionType::LIST:
+      sink << schema->values.at(std::get<ListValues>(values).current_value).str();
+      return;
+    case OptionType::SET:
+      sink << std::get<SetValues>(values).current_value;
+      return;
+    case OptionType::OPTIONS:
+    {
+      for (const Option& option : get_options().get_options())
+      {
+        if (!option.has_changed())
+        {
+          continue;
+        }
+
+        sink << "\n            ";
+        option.write(sink);
+      }
+
+      sink << "\n        ";
+      return;
+    }
+  }
+}
+
+bool Option::is_required() const
+{
+  return schema->required;
+}
+
+bool Option::has_changed() const
+{
+  return std::visit([this](const auto& values) {
+    return is_changed(values, is_required());
+  }, values);
+}
+
+void Option::set_default(const std::string& default_value)
+{
+  switch (get_type())
+  {
+    case OptionType::STRING:
+      std::get<StringValues>(values).default_value = default_value;
+      break;
+    case OptionType::NUMBER:
+      std::get<NumberValues>(values).default_value = std::stoi(default_value);
+      break;
+    case OptionType::LIST:
+      std::get<ListValues>(values).default_value = find_value(default_value);
+      break;
+    case OptionType::SET:
+      std::get<SetValues>(values).default_value = default_value;
+      break;
+    case OptionType::OPTIONS:
+      return;
+  }
+
+  set_current(default_value);
+}
+
+void Option::set_current(const std::string& current_value)
+{
+  edit_current(current_value);
+  set_previous();
+}
+
+void Option::edit_current(const std::string& current_value)
+{
+  bool changed = false;
+
+  switch (get_type())
+  {
+    case OptionType::STRING:
+      changed = assign(std::get<StringValues>(values).current_value, current_value);
+      break;
+    case OptionType::NUMBER:
+      changed = assign(std::get<NumberValues>(values).current_value, std::stoi(current_value));
+      break;
+    case OptionType::LIST:
+      changed = assign(std::get<ListValues>(values).current_value, find_value(current_value));
+      break;
+    case OptionType::SET:
+      changed = assign(std::get<SetValues>(values).current_value, current_value);
+      break;
+    case OptionType::OPTIONS:
+      return;
+  }
+
+  if (changed)
+  {
+    bump_generation();
+  }
+}
+
+void Option::set_previous()
+{
+  std::visit([](auto& values) {
+    save_previous(values);
+  }, values);
+}
+
+void Option::restore_default()
+{
+  if (std::visit([](auto& values) { return reset_to_default(values); }, values))
+  {
+    bump_generation();
+  }
+}
+
+void Option::restore_previous()
+{
+  if (std::visit([](auto& values) { return reset_to_previous(values); }, values))
+  {
+    bump_generation();
+  }
+}
+
+Options& Option::get_options()
+{
+  return *std::get<ExternValues>(values).options;
+}
+
+const Options& Option::get_options() const
+{
+  return *std::get<ExternValues>(values).options;
+}
+
+void Option::set_options(const Options& options)
+{
+  std::unique_ptr<Options>& extern_options = std::get<ExternValues>(values).options;
+  extern_options = std::make_unique<Options>(options);
+  extern_options->get_generation().set_parent(generation);
+
+  bump_generation();
+}
+
+void Option::set_values(const Option& other)
+{
+  values = other.values;
+  set_generation(generation);
+
+  bump_generation();
+}
+
+void Option::set_generation(Generation* generation)
+{
+  this->generation = generation;
+
+  if (get_type() == OptionType::OPTIONS && std::get<ExternValues>(values).options)
+  {
+    get_options().get_generation().set_parent(generation);
+  }
+}
+
+const std::string Option::to_string() const
+{
+  std::string config;
+  StringSink sink(config);
+  write(sink);
+
+  return config;
+}
+
+void Option::write(Sink& sink) const
+{
+  sink << get_name() << '(';
+  write_value(sink);
+  sink << ')';
+}
+
+void Option::bump_generation()
+{
+  if (generation)
+  {
+    generation->bump();
+  }
+}
+
+int Option::find_value(const std::string& value) const
+{
+  // a string that was never interned can't be one of the values
+  Atom atom;
+  if (!Atom::find(value, atom))
+  {
+    return -1;
+  }
+
+  const std::vector<Atom>& values = schema->values;
+  auto it = std::find(values.cbegin(), values.cend(), atom);
+
+  if (it != values.cend())
+  {
+    return std::distance(values.cbegin(), it);
+  }
+  else
+  {
+    return -1;
+  }
+}
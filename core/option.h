@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef OPTION_H
+#define OPTION_H
+
+#include "schema.h"
+#include "generation.h"
+
+#include <memory>
+#include <variant>
+
+class Options;
+class Sink;
+
+/*
+ * Default, current and previous value of a simple option.
+ * @type only makes the String/Set and Number/List alternatives distinct types.
+ */
+template<typename Value, OptionType type>
+struct SimpleValues
+{
+  Value default_value;
+  Value current_value;
+  Value previous_value;
+};
+
+// represented by a QLineEdit
+typedef SimpleValues<std::string, OptionType::STRING> StringValues;
+
+// represented by a QSpinBox, -1 means unset
+typedef SimpleValues<int, OptionType::NUMBER> NumberValues;
+
+// represented by a QComboBox, holds the index of the selected value from the schema's values
+typedef SimpleValues<int, OptionType::LIST> ListValues;
+
+// represented by multiple QCheckBoxes, the selected values are stored as a string
+typedef SimpleValues<std::string, OptionType::SET> SetValues;
+
+/*
+ * Values of an option that contains other options, e.g. tls() or value-pairs().
+ * Represented by a button which opens a new dialog with options.
+ */
+struct ExternValues
+{
+  std::unique_ptr<Options> options;
+
+  ExternValues();
+  ExternValues(const ExternValues& other);
+  ExternValues(ExternValues&& other) noexcept;
+  ExternValues& operator=(const ExternValues& other);
+  ExternValues& operator=(ExternValues&& other) noexcept;
+  ~ExternValues();
+};
+
+/*
+ * An option of an Object, stored by value in the Object.
+ * The name, description, etc. are shared between all the copies of an option,
+ * only the values are stored per instance, in a tagged union instead of a class hierarchy.
+ */
+class Option
+{
+public:
+  typedef std::variant<StringValues, NumberValues, ListValues, SetValues, ExternValues> Values;
+
+private:
+  std::shared_ptr<const OptionSchema> schema;
+  Values values;
+  Generation* generation = nullptr;
+
+public:
+  Option(std::shared_ptr<const OptionSchema> schema, OptionType type);
+
+  OptionType get_type() const;
+  const std::string& get_name() const;
+  const std::string& get_description() const;
+  const OptionSchema& get_schema() const;
+  const std::string get_current_value() const;
+
+  /*
+   * Writes the current value to @sink in syslog-ng syntax, the same as get_current_value().
+   */
+  void write_value(Sink& sink) const;
+
+  bool is_required() const;
+  bool has_changed() const;
+
+  /*
+   * @return: returns the default, current and previous values, the alternative is get_type().
+   */
+  const Values& get_values() const;
+
+  void set_default(const std::string& default_value);
+  void set_current(const std::string& current_value);
+
+  /*
+   * Sets the current value like set_current, but keeps the previous one,
+   * so the edit can still be undone with restore_previous.
+   */
+  void edit_current(const std::string& current_value);
+
+  void set_previous();
+
+  void restore_default();
+  void restore_previous();
+
+  /*
+   * Copies the values of @other, an option of the same schema, the nested Options of OptionType::OPTIONS too.
+   */
+  void set_values(const Option& other);
+
+  /*
+   * Only for OptionType::OPTIONS.
+   */
+  Options& get_options();
+  const Options& get_options() const;
+  void set_options(const Options& options);
+
+  /*
+   * Changes of the current value are counted in @generation, nullptr for not counting them.
+   * The Generation of nested Options counts in @generation too.
+   */
+  void set_generation(Generation* generation);
+
+  const std::string to_string() const;
+
+  /*
+   * Writes the option to @sink in syslog-ng syntax, the same as to_string().
+   */
+  void write(Sink& sink) const;
+
+private:
+  void bump_generation();
+
+  /*
+   * @return: returns the position of @value in the schema's values, -1 if it's not there.
+   */
+  int find_value(const std::string& value) const;
+};
+
+#endif  // OPTION_H
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Calls @function(i) for every i in [0, @count) on a pool of @n_threads threads,
+ * the calling thread included. 0 means one thread per core.
+ * The first exception thrown by @function is rethrown after all threads are joined.
+ */
+template<typename Function>
+void parallel_for(std::size_t count, unsigned int n_threads, Function function)
+{
+  if (n_threads == 0)
+  {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  std::atomic<std::size_t> next(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < count; i = next++)
+    {
+      try
+      {
+        function(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+        next = count;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < n_threads && i < count; i++)
+  {
+    threads.emplace_back(worker);
+  }
+
+  worker();
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+/*
+ * Calls @produce(i, buffer) for every i in [0, @count) on @n_threads threads, 0 means one per core,
+ * and @consume(i, buffer) on the calling thread in the order of i, as soon as the buffer of i is produced.
+ * The same threads run from the first element to the last, and they go on producing while the calling thread consumes.
+ * At most @window buffers are held at a time, a thread waits for the oldest one to be consumed before producing past it.
+ * The first exception thrown by @produce or @consume is rethrown after all threads are joined.
+ */
+template<typename Produce, typename Consume>
+void parallel_ordered(std::size_t count, unsigned int n_threads, std::size_t window, Produce produce, Consume consume)
+{
+  if (n_threads == 0)
+  {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  window = std::max<std::size_t>(window, 1);
+
+  std::vector<std::string> buffers(window);
+  std::vector<char> produced(window, false);
+
+  std::mutex mutex;
+  std::condition_variable produced_condition;
+  std::condition_variable consumed_condition;
+  std::size_t next = 0;
+  std::size_t consumed = 0;
+  unsigned int n_waiting = 0;  // threads waiting for a buffer to be consumed
+  bool failed = false;
+  std::exception_ptr error;
+
+  auto fail = [&](std::exception_ptr exception) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error)
+    {
+      error = exception;
+    }
+    failed = true;
+    produced_condition.notify_all();
+    consumed_condition.notify_all();
+  };
+
+  auto worker = [&]() {
+    for (;;)
+    {
+      std::size_t i;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!failed && next < count && next >= consumed + window)
+        {
+          n_waiting++;
+          consumed_condition.wait(lock);
+          n_waiting--;
+        }
+
+        if (failed || next >= count)
+        {
+          return;
+        }
+        i = next++;
+      }
+
+      // the buffer of i is free: the element before it in the same buffer was consumed
+      std::string& buffer = buffers[i % window];
+      try
+      {
+        buffer.clear();
+        produce(i, buffer);
+      }
+      catch (...)
+      {
+        fail(std::current_exception());
+        return;
+      }
+
+      // the calling thread only waits for the next buffer in order
+      bool next_in_order;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        produced[i % window] = true;
+        next_in_order = i == consumed;
+      }
+
+      if (next_in_order)
+      {
+        produced_condition.notify_one();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < n_threads && i < count; i++)
+  {
+    threads.emplace_back(worker);
+  }
+
+  try
+  {
+    for (std::size_t i = 0; i < count; i++)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        produced_condition.wait(lock, [&]() { return failed || produced[i % window]; });
+        if (failed)
+        {
+          break;
+        }
+      }
+
+      // not touched by the threads until it's marked consumed
+      consume(i, buffers[i % window]);
+
+      bool waiting;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        produced[i % window] = false;
+        consumed = i + 1;
+        waiting = n_waiting != 0;
+      }
+
+      if (waiting)
+      {
+        consumed_condition.notify_one();
+      }
+    }
+  }
+  catch (...)
+  {
+    fail(std::current_exception());
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+#endif  // PARALLEL_H
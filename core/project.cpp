@@ -0,0 +1,590 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "project.h"
+#include "config.h"
+#include "sink.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+  const char magic[8] = { 'S', 'N', 'G', 'C', 'P', 'R', 'O', 'J' };
+  const std::uint32_t project_version = 1;
+  const std::uint32_t byte_order = 0x01020304;
+
+  enum Section { OPTIONS, OBJECTS, MEMBERS, OBJECT_STATEMENTS, LOG_STATEMENTS, ICONS, STRINGS, SECTION_COUNT };
+
+  // followed by the section table, the sections are 4 byte aligned
+  struct Header
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t section_count;
+    ProjectWriter::Range global_options;
+  };
+
+  static_assert(sizeof(Header) == 28, "the header is written as it is");
+  static_assert(sizeof(ProjectReader::Section) == 12, "the section table is written as it is");
+  static_assert(sizeof(ProjectIcon) == 16, "the icons are written as they are");
+
+  std::size_t padding(std::size_t size)
+  {
+    return (4 - size % 4) % 4;
+  }
+
+  // the value as Option::set_current takes it, not as it's written in the configuration
+  std::string get_raw_value(const Option& option)
+  {
+    const Option::Values& values = option.get_values();
+
+    switch (option.get_type())
+    {
+      case OptionType::STRING:
+        return std::get<StringValues>(values).current_value;
+      case OptionType::NUMBER:
+        return std::to_string(std::get<NumberValues>(values).current_value);
+      case OptionType::LIST:
+      {
+        const int index = std::get<ListValues>(values).current_value;
+        const std::vector<Atom>& list = option.get_schema().values;
+        return index >= 0 && static_cast<std::size_t>(index) < list.size() ? list[index].str() : std::string();
+      }
+      case OptionType::SET:
+        return std::get<SetValues>(values).current_value;
+      case OptionType::OPTIONS:
+        break;
+    }
+
+    return std::string();
+  }
+
+  // a value the schema doesn't accept any more is skipped instead of failing in set_current
+  bool is_valid_value(const Option& option, const std::string& value)
+  {
+    switch (option.get_type())
+    {
+      case OptionType::NUMBER:
+      {
+        int number = 0;
+        const std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(), number);
+        return result.ec == std::errc() && result.ptr == value.data() + value.size();
+      }
+      case OptionType::LIST:
+      {
+        const std::vector<Atom>& list = option.get_schema().values;
+        return std::any_of(list.begin(), list.end(), [&value](const Atom& atom) { return atom.str() == value; });
+      }
+      default:
+        return true;
+    }
+  }
+
+  template<typename Record>
+  void write_section(Sink& sink, const std::vector<Record>& records)
+  {
+    const std::size_t size = records.size() * sizeof(Record);
+    sink.write(reinterpret_cast<const char*>(records.data()), size);
+    sink.write("\0\0\0", padding(size));
+  }
+}
+
+
+ProjectWriter::ProjectWriter(Config& config)
+{
+  global_options = add_options(config.get_global_options());
+
+  for (const ObjectStatement& object_statement : config.get_object_statements())
+  {
+    add_object_statement(object_statement);
+  }
+
+  for (const LogStatement& log_statement : config.get_log_statements())
+  {
+    add_log_statement(log_statement);
+  }
+}
+
+std::uint32_t ProjectWriter::add_object(const Object& object)
+{
+  auto index = object_indices.find(&object);
+  if (index != object_indices.end())
+  {
+    return index->second;
+  }
+
+  ObjectRecord record { add_string(object.get_type()), add_string(object.get_name()), add_options(object), 0, StringRef { 0, 0 } };
+
+  const Filter* filter = dynamic_cast<const Filter*>(&object);
+  if (filter)
+  {
+    record.invert = filter->get_invert();
+    record.next = add_string(filter->get_next());
+  }
+
+  objects.push_back(record);
+  object_indices.emplace(&object, objects.size() - 1);
+
+  return objects.size() - 1;
+}
+
+void ProjectWriter::add_object_icon(const Object& object, int x, int y)
+{
+  icons.push_back(ProjectIcon { ProjectIcon::OBJECT, add_object(object), x, y });
+}
+
+void ProjectWriter::add_object_statement_icon(const ObjectStatement& object_statement, bool copy, int x, int y)
+{
+  icons.push_back(ProjectIcon { copy ? ProjectIcon::OBJECT_STATEMENT_COPY : ProjectIcon::OBJECT_STATEMENT,
+                                object_statement_indices.at(&object_statement), x, y });
+}
+
+void ProjectWriter::add_log_statement_icon(const LogStatement& log_statement, int x, int y)
+{
+  icons.push_back(ProjectIcon { ProjectIcon::LOG_STATEMENT, log_statement_indices.at(&log_statement), x, y });
+}
+
+void ProjectWriter::write(Sink& sink) const
+{
+  const Header header { { magic[0], magic[1], magic[2], magic[3], magic[4], magic[5], magic[6], magic[7] },
+                        project_version, byte_order, SECTION_COUNT, global_options };
+
+  const std::size_t sizes[SECTION_COUNT][2] {
+    { options.size(), sizeof(OptionRecord) },
+    { objects.size(), sizeof(ObjectRecord) },
+    { members.size(), sizeof(std::uint32_t) },
+    { object_statements.size(), sizeof(ObjectStatementRecord) },
+    { log_statements.size(), sizeof(LogStatementRecord) },
+    { icons.size(), sizeof(ProjectIcon) },
+    { strings.size(), 1 }
+  };
+
+  std::vector<ProjectReader::Section> sections;
+  std::size_t offset = sizeof(Header) + SECTION_COUNT * sizeof(ProjectReader::Section);
+  for (const auto& size : sizes)
+  {
+    const std::size_t section_size = size[0] * size[1];
+    if (offset + section_size > UINT32_MAX)
+    {
+      throw std::length_error("the project is larger than 4 GB");
+    }
+
+    sections.push_back(ProjectReader::Section { std::uint32_t(offset), std::uint32_t(size[0]), std::uint32_t(size[1]) });
+    offset += section_size + padding(section_size);
+  }
+
+  sink.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  write_section(sink, sections);
+
+  write_section(sink, options);
+  write_section(sink, objects);
+  write_section(sink, members);
+  write_section(sink, object_statements);
+  write_section(sink, log_statements);
+  write_section(sink, icons);
+  sink.write(strings.data(), strings.size());
+}
+
+std::uint32_t ProjectWriter::add_object_statement(const ObjectStatement& object_statement)
+{
+  std::vector<std::uint32_t> indices;
+  for (const std::shared_ptr<const Object>& object : object_statement.get_objects())
+  {
+    indices.push_back(add_object(*object));
+  }
+
+  object_statements.push_back(ObjectStatementRecord { add_string(object_statement.get_id()),
+                                                      Range { std::uint32_t(members.size()), std::uint32_t(indices.size()) } });
+  members.insert(members.end(), indices.begin(), indices.end());
+  object_statement_indices.emplace(&object_statement, object_statements.size() - 1);
+
+  return object_statements.size() - 1;
+}
+
+std::uint32_t ProjectWriter::add_log_statement(const LogStatement& log_statement)
+{
+  const Range options_range = add_options(log_statement.get_options());
+  const Range object_statements_range { std::uint32_t(members.size()), std::uint32_t(log_statement.get_object_statements().size()) };
+
+  for (const std::shared_ptr<const ObjectStatement>& object_statement : log_statement.get_object_statements())
+  {
+    members.push_back(object_statement_indices.at(object_statement.get()));
+  }
+
+  log_statements.push_back(LogStatementRecord { options_range, object_statements_range });
+  log_statement_indices.emplace(&log_statement, log_statements.size() - 1);
+
+  return log_statements.size() - 1;
+}
+
+// the options of an object are next to each other, the nested options of an option come after them
+ProjectWriter::Range ProjectWriter::add_options(const Object& object)
+{
+  std::vector<const Option*> changed;
+  for (const Option& option : object.get_options())
+  {
+    if (option.has_changed())
+    {
+      changed.push_back(&option);
+    }
+  }
+
+  const Range range { std::uint32_t(options.size()), std::uint32_t(changed.size()) };
+  options.resize(options.size() + changed.size());
+
+  for (std::size_t i = 0; i < changed.size(); i++)
+  {
+    const Option& option = *changed[i];
+    OptionRecord record { add_string(option.get_name()), StringRef { 0, 0 }, Range { 0, 0 } };
+
+    if (option.get_type() == OptionType::OPTIONS)
+    {
+      record.options = add_options(option.get_options());
+    }
+    else
+    {
+      record.value = add_string(get_raw_value(option));
+    }
+
+    options[range.first + i] = record;
+  }
+
+  return range;
+}
+
+ProjectWriter::StringRef ProjectWriter::add_string(const std::string& string)
+{
+  auto string_ref = string_refs.find(string);
+  if (string_ref != string_refs.end())
+  {
+    return string_ref->second;
+  }
+
+  const StringRef new_string_ref { std::uint32_t(strings.size()), std::uint32_t(string.size()) };
+  strings += string;
+  string_refs.emplace(string, new_string_ref);
+
+  return new_string_ref;
+}
+
+
+ProjectReader::ProjectReader(Config& config) :
+  config(config)
+{}
+
+void ProjectReader::open(const std::string& file_name)
+{
+  file.setFileName(QString::fromStdString(file_name));
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    throw std::runtime_error(file_name + ": can't open the file");
+  }
+
+  const qint64 size = file.size();
+  const char* map = size > 0 ? reinterpret_cast<const char*>(file.map(0, size)) : nullptr;
+  if (map)
+  {
+    open_data(std::string_view(map, size));
+  }
+  else
+  {
+    contents = file.readAll();
+    open_data(std::string_view(contents.constData(), contents.size()));
+  }
+}
+
+void ProjectReader::open_data(std::string_view data)
+{
+  Header header;
+  if (data.size() < sizeof(Header))
+  {
+    throw std::runtime_error("not a syslog-ng-config project");
+  }
+
+  std::memcpy(&header, data.data(), sizeof(Header));
+
+  if (!std::equal(magic, magic + sizeof(magic), header.magic))
+  {
+    throw std::runtime_error("not a syslog-ng-config project");
+  }
+
+  if (header.byte_order != byte_order)
+  {
+    throw std::runtime_error("the project was saved on a machine with a different byte order");
+  }
+
+  if (header.version > project_version)
+  {
+    throw std::runtime_error("the project was saved by a newer version, " + std::to_string(header.version));
+  }
+
+  // newer versions may add sections at the end of the table
+  if (header.section_count < SECTION_COUNT ||
+    sizeof(Header) + std::uint64_t(header.section_count) * sizeof(Section) > data.size())
+  {
+    throw std::runtime_error("the section table of the project is damaged");
+  }
+
+  sections.resize(SECTION_COUNT);
+  std::memcpy(sections.data(), data.data() + sizeof(Header), SECTION_COUNT * sizeof(Section));
+
+  const std::size_t record_sizes[SECTION_COUNT] {
+    sizeof(ProjectWriter::OptionRecord), sizeof(ProjectWriter::ObjectRecord), sizeof(std::uint32_t),
+    sizeof(ProjectWriter::ObjectStatementRecord), sizeof(ProjectWriter::LogStatementRecord), sizeof(ProjectIcon), 1
+  };
+
+  for (std::size_t i = 0; i < SECTION_COUNT; i++)
+  {
+    const Section& section = sections[i];
+    if (section.record_size < record_sizes[i] ||
+      section.offset + std::uint64_t(section.count) * section.record_size > data.size())
+    {
+      throw std::runtime_error("a section of the project is damaged");
+    }
+  }
+
+  this->data = data;
+  version = header.version;
+  global_options = header.global_options;
+
+  objects.assign(sections[OBJECTS].count, nullptr);
+  object_statements.assign(sections[OBJECT_STATEMENTS].count, nullptr);
+  log_statements.assign(sections[LOG_STATEMENTS].count, nullptr);
+  warnings.clear();
+}
+
+std::uint32_t ProjectReader::get_version() const
+{
+  return version;
+}
+
+void ProjectReader::load_global_options()
+{
+  load_global_options(config.get_global_options());
+}
+
+void ProjectReader::load_global_options(Options& options)
+{
+  read_options(options, global_options);
+}
+
+void ProjectReader::load_statements()
+{
+  for (std::size_t i = 0; i < object_statements.size(); i++)
+  {
+    get_object_statement(i);
+  }
+
+  for (std::size_t i = 0; i < log_statements.size(); i++)
+  {
+    get_log_statement(i);
+  }
+}
+
+std::size_t ProjectReader::get_object_count() const
+{
+  return objects.size();
+}
+
+std::size_t ProjectReader::get_object_statement_count() const
+{
+  return object_statements.size();
+}
+
+std::size_t ProjectReader::get_log_statement_count() const
+{
+  return log_statements.size();
+}
+
+std::size_t ProjectReader::get_icon_count() const
+{
+  return sections.empty() ? 0 : sections[ICONS].count;
+}
+
+std::shared_ptr<Object> ProjectReader::get_object(std::size_t index)
+{
+  const ProjectWriter::ObjectRecord record = read<ProjectWriter::ObjectRecord>(OBJECTS, index);
+  if (objects[index])
+  {
+    return objects[index];
+  }
+
+  const std::string type(read_string(record.type));
+  const std::string name(read_string(record.name));
+
+  std::shared_ptr<Object> object;
+  try
+  {
+    object = config.create_object(name, type);
+  }
+  catch (const std::out_of_range&)
+  {
+    warnings.push_back("no " + type + " named " + name);
+    return nullptr;
+  }
+
+  read_options(*object, record.options);
+
+  Filter* filter = dynamic_cast<Filter*>(object.get());
+  if (filter)
+  {
+    filter->set_invert(record.invert);
+    filter->set_next(std::string(read_string(record.next)));
+  }
+
+  objects[index] = object;
+  return object;
+}
+
+std::shared_ptr<ObjectStatement> ProjectReader::get_object_statement(std::size_t index)
+{
+  const ProjectWriter::ObjectStatementRecord record = read<ProjectWriter::ObjectStatementRecord>(OBJECT_STATEMENTS, index);
+  if (object_statements[index])
+  {
+    return object_statements[index];
+  }
+
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(std::string(read_string(record.id)));
+  object_statements[index] = object_statement;
+
+  for (std::size_t i = 0; i < record.objects.count; i++)
+  {
+    std::shared_ptr<Object> object = get_object(read_member(record.objects, i));
+    if (object)
+    {
+      object_statement->add_object(object, object_statement->get_objects().size());
+    }
+  }
+
+  return object_statement;
+}
+
+std::shared_ptr<LogStatement> ProjectReader::get_log_statement(std::size_t index)
+{
+  const ProjectWriter::LogStatementRecord record = read<ProjectWriter::LogStatementRecord>(LOG_STATEMENTS, index);
+  if (log_statements[index])
+  {
+    return log_statements[index];
+  }
+
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+  log_statements[index] = log_statement;
+
+  read_options(log_statement->get_options(), record.options);
+
+  for (std::size_t i = 0; i < record.object_statements.count; i++)
+  {
+    log_statement->add_object_statement(get_object_statement(read_member(record.object_statements, i)),
+                                        log_statement->get_object_statements().size());
+  }
+
+  return log_statement;
+}
+
+ProjectIcon ProjectReader::get_icon(std::size_t index) const
+{
+  const ProjectIcon icon = read<ProjectIcon>(ICONS, index);
+  if (icon.kind > ProjectIcon::LOG_STATEMENT)
+  {
+    throw std::runtime_error("unknown icon in the project");
+  }
+
+  return icon;
+}
+
+const std::vector<std::string>& ProjectReader::get_warnings() const
+{
+  return warnings;
+}
+
+template<typename Record>
+Record ProjectReader::read(std::size_t section, std::size_t index) const
+{
+  if (sections.empty() || index >= sections[section].count)
+  {
+    throw std::runtime_error("a record of the project is out of bounds");
+  }
+
+  Record record;
+  std::memcpy(&record, data.data() + sections[section].offset + index * sections[section].record_size, sizeof(Record));
+
+  return record;
+}
+
+std::string_view ProjectReader::read_string(const ProjectWriter::StringRef& string) const
+{
+  if (std::uint64_t(string.offset) + string.size > sections[STRINGS].count)
+  {
+    throw std::runtime_error("a string of the project is out of bounds");
+  }
+
+  return data.substr(sections[STRINGS].offset + string.offset, string.size);
+}
+
+std::uint32_t ProjectReader::read_member(const ProjectWriter::Range& range, std::size_t index) const
+{
+  return read<std::uint32_t>(MEMBERS, std::size_t(range.first) + index);
+}
+
+void ProjectReader::read_options(Object& object, const ProjectWriter::Range& range)
+{
+  for (std::size_t i = 0; i < range.count; i++)
+  {
+    const std::size_t index = std::size_t(range.first) + i;
+    const ProjectWriter::OptionRecord record = read<ProjectWriter::OptionRecord>(OPTIONS, index);
+    const std::string_view name = read_string(record.name);
+
+    OptionVector& options = object.get_options();
+    auto option = std::find_if(options.begin(), options.end(), [&name](const Option& option) {
+      return option.get_name() == name;
+    });
+
+    if (option == options.end())
+    {
+      warnings.push_back("no option of " + object.get_name() + " named " + std::string(name));
+      continue;
+    }
+
+    if (option->get_type() == OptionType::OPTIONS)
+    {
+      // nested options always come later, a damaged file can't make a loop
+      if (record.options.count > 0 && record.options.first <= index)
+      {
+        throw std::runtime_error("the options of the project are damaged");
+      }
+
+      read_options(option->get_options(), record.options);
+      continue;
+    }
+
+    const std::string value(read_string(record.value));
+    if (!is_valid_value(*option, value))
+    {
+      warnings.push_back("invalid value of " + object.get_name() + " " + std::string(name) + ": " + value);
+      continue;
+    }
+
+    option->set_current(value);
+  }
+}
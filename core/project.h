@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef PROJECT_H
+#define PROJECT_H
+
+#include <QFile>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Config;
+class Object;
+class Options;
+class ObjectStatement;
+class LogStatement;
+class Sink;
+
+/*
+ * Position of an icon on the canvas, the center of the icon.
+ * Statements inside a log statement and objects inside a statement have no position, they are laid out.
+ */
+struct ProjectIcon
+{
+  enum Kind : std::uint32_t { OBJECT, OBJECT_STATEMENT, OBJECT_STATEMENT_COPY, LOG_STATEMENT };
+
+  Kind kind;
+  std::uint32_t index;  // of the element of its kind in the project
+  std::int32_t x;
+  std::int32_t y;
+};
+
+/*
+ * The native project format, a binary file that can be memory-mapped.
+ *
+ * A fixed header with the version and the offset, count and record size of each section,
+ * then the sections: options, objects, members, object statements, log statements, icons and a string table.
+ * Records refer to each other by index and to their strings by offset, so a record can be read
+ * without reading the ones before it.
+ *
+ * Objects and options are stored by name and only the options that differ from the default,
+ * so a project stays readable when the schemas change. Newer versions may append fields to the records.
+ */
+class ProjectWriter
+{
+public:
+  struct StringRef { std::uint32_t offset; std::uint32_t size; };
+  struct Range { std::uint32_t first; std::uint32_t count; };
+
+  struct OptionRecord { StringRef name; StringRef value; Range options; };
+  struct ObjectRecord { StringRef type; StringRef name; Range options; std::uint32_t invert; StringRef next; };
+  struct ObjectStatementRecord { StringRef id; Range objects; };
+  struct LogStatementRecord { Range options; Range object_statements; };
+
+private:
+  std::vector<OptionRecord> options;
+  std::vector<ObjectRecord> objects;
+  std::vector<std::uint32_t> members;
+  std::vector<ObjectStatementRecord> object_statements;
+  std::vector<LogStatementRecord> log_statements;
+  std::vector<ProjectIcon> icons;
+  Range global_options;
+
+  std::string strings;
+  std::unordered_map<std::string, StringRef> string_refs;
+
+  // element -> index of its record
+  std::unordered_map<const Object*, std::uint32_t> object_indices;
+  std::unordered_map<const ObjectStatement*, std::uint32_t> object_statement_indices;
+  std::unordered_map<const LogStatement*, std::uint32_t> log_statement_indices;
+
+public:
+  /*
+   * Adds the global options and the statements of @config, in the order of the configuration.
+   */
+  explicit ProjectWriter(Config& config);
+
+  /*
+   * @return: returns the index of @object, which can be outside of any statement.
+   */
+  std::uint32_t add_object(const Object& object);
+
+  void add_object_icon(const Object& object, int x, int y);
+  void add_object_statement_icon(const ObjectStatement& object_statement, bool copy, int x, int y);
+  void add_log_statement_icon(const LogStatement& log_statement, int x, int y);
+
+  void write(Sink& sink) const;
+
+private:
+  std::uint32_t add_object_statement(const ObjectStatement& object_statement);
+  std::uint32_t add_log_statement(const LogStatement& log_statement);
+  Range add_options(const Object& object);
+  StringRef add_string(const std::string& string);
+};
+
+/*
+ * Opens a project written by ProjectWriter.
+ * Opening only checks the header, the elements are created from their records when they are first requested,
+ * the objects of the statements and the statements of the logs with them.
+ * Throws std::runtime_error if the file is not a project, or a record is out of bounds.
+ */
+class ProjectReader
+{
+public:
+  struct Section { std::uint32_t offset; std::uint32_t count; std::uint32_t record_size; };
+
+private:
+  Config& config;
+
+  QFile file;
+  QByteArray contents;  // if the file can't be mapped
+  std::string_view data;
+
+  std::uint32_t version = 0;
+  ProjectWriter::Range global_options;
+  std::vector<Section> sections;
+
+  std::vector< std::shared_ptr<Object> > objects;
+  std::vector< std::shared_ptr<ObjectStatement> > object_statements;
+  std::vector< std::shared_ptr<LogStatement> > log_statements;
+
+  std::vector<std::string> warnings;
+
+public:
+  explicit ProjectReader(Config& config);
+
+  void open(const std::string& file_name);
+
+  /*
+   * @data: has to outlive the ProjectReader.
+   */
+  void open_data(std::string_view data);
+
+  std::uint32_t get_version() const;
+
+  void load_global_options();
+
+  /*
+   * Loads the global options into @options instead of the ones of the Config,
+   * a copy that can be applied once the rest of the project is loaded too.
+   */
+  void load_global_options(Options& options);
+
+  /*
+   * Creates every statement in the order they were saved,
+   * the order of the configuration if they are requested one by one is the order of the requests.
+   */
+  void load_statements();
+
+  std::size_t get_object_count() const;
+  std::size_t get_object_statement_count() const;
+  std::size_t get_log_statement_count() const;
+  std::size_t get_icon_count() const;
+
+  std::shared_ptr<Object> get_object(std::size_t index);
+  std::shared_ptr<ObjectStatement> get_object_statement(std::size_t index);
+  std::shared_ptr<LogStatement> get_log_statement(std::size_t index);
+  ProjectIcon get_icon(std::size_t index) const;
+
+  /*
+   * @return: returns the objects, options and values which are not in the schemas any more, and were skipped.
+   */
+  const std::vector<std::string>& get_warnings() const;
+
+private:
+  template<typename Record>
+  Record read(std::size_t section, std::size_t index) const;
+
+  std::string_view read_string(const ProjectWriter::StringRef& string) const;
+  std::uint32_t read_member(const ProjectWriter::Range& range, std::size_t index) const;
+  void read_options(Object& object, const ProjectWriter::Range& range);
+};
+
+#endif  // PROJECT_H
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "schema.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <map>
+
+// only the yaml files are typed by name, the compiled in tables hold the enums
+static const std::map<std::string, ObjectType> object_type_map {
+  {"source", ObjectType::SOURCE},
+  {"destination", ObjectType::DESTINATION},
+  {"filter", ObjectType::FILTER},
+  {"template", ObjectType::TEMPLATE},
+  {"rewrite", ObjectType::REWRITE},
+  {"parser", ObjectType::PARSER},
+  {"options", ObjectType::OPTIONS}
+};
+
+static const std::map<std::string, OptionType> option_type_map {
+  {"string", OptionType::STRING},
+  {"number", OptionType::NUMBER},
+  {"list", OptionType::LIST},
+  {"set", OptionType::SET},
+  {"tls", OptionType::OPTIONS},
+  {"value-pairs", OptionType::OPTIONS}
+};
+
+ObjectType to_object_type(const std::string& type)
+{
+  return object_type_map.at(type);
+}
+
+OptionType to_option_type(const std::string& type)
+{
+  return option_type_map.at(type);
+}
+
+ObjectSchema read_schema(const std::string& file_name)
+{
+  const YAML::Node yaml_object = YAML::LoadFile(file_name);
+
+  ObjectSchema object;
+  object.name = Atom(yaml_object["name"].as<std::string>());
+  object.type = Atom(yaml_object["type"].as<std::string>());
+  object.object_type = to_object_type(object.type.str());
+  object.description = yaml_object["description"].as<std::string>();
+
+  const YAML::Node& options = yaml_object["options"];
+
+  for (YAML::const_iterator option_it = options.begin(); option_it != options.end(); ++option_it)
+  {
+    YAML::const_iterator tmp = option_it->begin();
+    const YAML::Node yaml_option = tmp->second;  // a copy, the iterator returns a temporary proxy
+
+    OptionSchema option;
+    option.name = Atom(tmp->first.as<std::string>());
+    option.type = Atom(yaml_option["type"].as<std::string>());
+    option.option_type = to_option_type(option.type.str());
+    option.description = yaml_option["description"].as<std::string>();
+
+    const YAML::Node& values = yaml_option["values"];
+    for (YAML::const_iterator value_it = values.begin(); value_it != values.end(); ++value_it)
+    {
+      option.values.emplace_back(value_it->as<std::string>());
+    }
+
+    if (yaml_option["default"])
+    {
+      option.default_value = yaml_option["default"].as<std::string>();
+      option.has_default = true;
+    }
+
+    if (yaml_option["required"])
+    {
+      option.required = yaml_option["required"].as<bool>();
+    }
+
+    if (yaml_option["min"])
+    {
+      option.minimum = yaml_option["min"].as<int>();
+    }
+
+    if (yaml_option["max"])
+    {
+      option.maximum = yaml_option["max"].as<int>();
+    }
+
+    if (yaml_option["pattern"])
+    {
+      option.pattern = yaml_option["pattern"].as<std::string>();
+    }
+
+    if (yaml_option["path"])
+    {
+      option.path = yaml_option["path"].as<bool>();
+    }
+
+    const YAML::Node& conflicts = yaml_option["conflicts"];
+    for (YAML::const_iterator conflict_it = conflicts.begin(); conflict_it != conflicts.end(); ++conflict_it)
+    {
+      option.conflicts.emplace_back(conflict_it->as<std::string>());
+    }
+
+    const YAML::Node& dependencies = yaml_option["requires"];
+    for (YAML::const_iterator dependency_it = dependencies.begin(); dependency_it != dependencies.end(); ++dependency_it)
+    {
+      option.dependencies.emplace_back(dependency_it->as<std::string>());
+    }
+
+    object.options.push_back(std::move(option));
+  }
+
+  return object;
+}
+
+ObjectSchema to_schema(const BuiltinObject& builtin)
+{
+  ObjectSchema object;
+  object.name = Atom(builtin.name);
+  object.type = Atom(builtin.type);
+  object.object_type = builtin.object_type;
+  object.description = builtin.description;
+  object.options.reserve(builtin.n_options);
+
+  for (const BuiltinOption* builtin_option = builtin.options; builtin_option != builtin.options + builtin.n_options; ++builtin_option)
+  {
+    OptionSchema option;
+    option.name = Atom(builtin_option->name);
+    option.type = Atom(builtin_option->type);
+    option.option_type = builtin_option->option_type;
+    option.description = builtin_option->description;
+    option.values.reserve(builtin_option->n_values);
+    for (const char* const* value = builtin_option->values; value != builtin_option->values + builtin_option->n_values; ++value)
+    {
+      option.values.emplace_back(*value);
+    }
+
+    if (builtin_option->default_value)
+    {
+      option.default_value = builtin_option->default_value;
+      option.has_default = true;
+    }
+
+    option.required = builtin_option->required;
+    option.minimum = builtin_option->minimum;
+    option.maximum = builtin_option->maximum;
+
+    if (builtin_option->pattern)
+    {
+      option.pattern = builtin_option->pattern;
+    }
+
+    option.path = builtin_option->path;
+
+    option.conflicts.reserve(builtin_option->n_conflicts);
+    for (const char* const* conflict = builtin_option->conflicts; conflict != builtin_option->conflicts + builtin_option->n_conflicts; ++conflict)
+    {
+      option.conflicts.emplace_back(*conflict);
+    }
+
+    option.dependencies.reserve(builtin_option->n_dependencies);
+    for (const char* const* dependency = builtin_option->dependencies; dependency != builtin_option->dependencies + builtin_option->n_dependencies; ++dependency)
+    {
+      option.dependencies.emplace_back(*dependency);
+    }
+
+    object.options.push_back(std::move(option));
+  }
+
+  return object;
+}
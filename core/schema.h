@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include "atom.h"
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstddef>
+
+class ConstraintTable;
+
+enum class ObjectType { SOURCE, DESTINATION, FILTER, TEMPLATE, REWRITE, PARSER, OPTIONS };
+
+// same order as the alternatives of Option::Values
+enum class OptionType { STRING, NUMBER, LIST, SET, OPTIONS };
+
+/*
+ * Plain description of an option, as read from a yaml file.
+ */
+struct OptionSchema
+{
+  Atom name;
+  Atom type;  // the name of the Options for OptionType::OPTIONS, like tls
+  OptionType option_type = OptionType::STRING;
+  std::string description;
+  std::vector<Atom> values;
+  std::string default_value;
+  bool has_default = false;
+  bool required = false;
+
+  // constraints of the current value, see ConstraintTable
+  int minimum = std::numeric_limits<int>::min();
+  int maximum = std::numeric_limits<int>::max();
+  std::string pattern;  // ECMAScript regex matching the whole value, empty for any value
+  bool path = false;  // the value is an absolute file system path
+  std::vector<Atom> conflicts;  // options that can't be set together with this one
+  std::vector<Atom> dependencies;  // options that have to be set if this one is set
+};
+
+/*
+ * Plain description of a default Object, as read from a yaml file.
+ * Config creates the default Objects from these.
+ */
+struct ObjectSchema
+{
+  Atom name;
+  Atom type;
+  ObjectType object_type = ObjectType::SOURCE;
+  std::string description;
+  std::vector<OptionSchema> options;
+
+  // the constraints of the options compiled by Config when the schema is loaded, nullptr if there are none
+  std::shared_ptr<const ConstraintTable> constraints;
+};
+
+/*
+ * Compiled in counterpart of OptionSchema, see BuiltinObject.
+ */
+struct BuiltinOption
+{
+  const char* name;
+  const char* type;
+  OptionType option_type;
+  const char* description;
+  const char* const* values;
+  std::size_t n_values;
+  const char* default_value;  // nullptr if there is no default
+  bool required;
+  int minimum;
+  int maximum;
+  const char* pattern;  // nullptr if there is no pattern
+  bool path;
+  const char* const* conflicts;
+  std::size_t n_conflicts;
+  const char* const* dependencies;
+  std::size_t n_dependencies;
+};
+
+/*
+ * Compiled in counterpart of ObjectSchema.
+ * The tables are generated from the objects directory by schemagen at build time.
+ */
+struct BuiltinObject
+{
+  const char* name;
+  const char* type;
+  ObjectType object_type;
+  const char* description;
+  const BuiltinOption* options;
+  std::size_t n_options;
+};
+
+extern const BuiltinObject builtin_objects[];
+extern const std::size_t n_builtin_objects;
+
+/*
+ * @return: returns the ObjectType of the @type of a yaml file, like source.
+ * Throws std::out_of_range if there is no such type.
+ */
+ObjectType to_object_type(const std::string& type);
+
+/*
+ * @return: returns the OptionType of the @type of an option in a yaml file, like string or tls.
+ * Throws std::out_of_range if there is no such type.
+ */
+OptionType to_option_type(const std::string& type);
+
+/*
+ * Read the @file_name yaml file.
+ * Throws YAML::Exception if the file is missing or malformed, std::out_of_range if a type is unknown.
+ */
+ObjectSchema read_schema(const std::string& file_name);
+
+/*
+ * @return: returns the ObjectSchema described by @builtin.
+ */
+ObjectSchema to_schema(const BuiltinObject& builtin);
+
+#endif  // SCHEMA_H
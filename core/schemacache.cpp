@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "schemacache.h"
+
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+
+// "SCHM", bump the version whenever ObjectSchema or the layout below changes
+static const quint32 magic = 0x5343484d;
+static const quint32 version = 3;
+
+// magic, version and index size
+static const int header_size = 3 * sizeof(quint32);
+
+static void write_string(QDataStream& out, const std::string& string)
+{
+  out << QByteArray::fromStdString(string);
+}
+
+static void read_string(QDataStream& in, std::string& string)
+{
+  QByteArray array;
+  in >> array;
+  string = array.toStdString();
+}
+
+static void read_atom(QDataStream& in, Atom& atom)
+{
+  std::string string;
+  read_string(in, string);
+  atom = Atom(string);
+}
+
+/*
+ * Reads the count of the elements that follow.
+ * Every element takes at least 4 bytes, a larger count can only come from a damaged file,
+ * it's rejected before anything is allocated for it.
+ * @return: false if the count was not read or is too large.
+ */
+static bool read_count(QDataStream& in, quint32& count)
+{
+  in >> count;
+  return in.status() == QDataStream::Ok && count <= in.device()->bytesAvailable() / 4;
+}
+
+static QByteArray serialize(const ObjectSchema& object)
+{
+  QByteArray data;
+  QDataStream out(&data, QIODevice::WriteOnly);
+  out.setVersion(QDataStream::Qt_5_0);
+
+  write_string(out, object.name.str());
+  write_string(out, object.type.str());
+  out << quint8(object.object_type);
+  write_string(out, object.description);
+
+  out << quint32(object.options.size());
+  for (const OptionSchema& option : object.options)
+  {
+    write_string(out, option.name.str());
+    write_string(out, option.type.str());
+    out << quint8(option.option_type);
+    write_string(out, option.description);
+
+    out << quint32(option.values.size());
+    for (const Atom& value : option.values)
+    {
+      write_string(out, value.str());
+    }
+
+    write_string(out, option.default_value);
+    out << option.has_default << option.required;
+
+    out << qint32(option.minimum) << qint32(option.maximum);
+    write_string(out, option.pattern);
+    out << option.path;
+
+    out << quint32(option.conflicts.size());
+    for (const Atom& conflict : option.conflicts)
+    {
+      write_string(out, conflict.str());
+    }
+
+    out << quint32(option.dependencies.size());
+    for (const Atom& dependency : option.dependencies)
+    {
+      write_string(out, dependency.str());
+    }
+  }
+
+  return data;
+}
+
+static bool deserialize(const QByteArray& data, ObjectSchema& object)
+{
+  QDataStream in(data);
+  in.setVersion(QDataStream::Qt_5_0);
+
+  read_atom(in, object.name);
+  read_atom(in, object.type);
+
+  quint8 object_type = 0;
+  in >> object_type;
+  if (object_type > quint8(ObjectType::OPTIONS))
+  {
+    return false;
+  }
+  object.object_type = ObjectType(object_type);
+
+  read_string(in, object.description);
+
+  quint32 n_options = 0;
+  if (!read_count(in, n_options))
+  {
+    return false;
+  }
+
+  object.options.clear();
+  object.options.reserve(n_options);
+
+  for (quint32 i = 0; i < n_options && in.status() == QDataStream::Ok; i++)
+  {
+    OptionSchema option;
+    read_atom(in, option.name);
+    read_atom(in, option.type);
+
+    quint8 option_type = 0;
+    in >> option_type;
+    if (option_type > quint8(OptionType::OPTIONS))
+    {
+      return false;
+    }
+    option.option_type = OptionType(option_type);
+
+    read_string(in, option.description);
+
+    quint32 n_values = 0;
+    if (!read_count(in, n_values))
+    {
+      return false;
+    }
+
+    option.values.resize(n_values);
+    for (Atom& value : option.values)
+    {
+      read_atom(in, value);
+    }
+
+    read_string(in, option.default_value);
+    in >> option.has_default >> option.required;
+
+    qint32 minimum = 0, maximum = 0;
+    in >> minimum >> maximum;
+    option.minimum = minimum;
+    option.maximum = maximum;
+    read_string(in, option.pattern);
+    in >> option.path;
+
+    quint32 n_conflicts = 0;
+    if (!read_count(in, n_conflicts))
+    {
+      return false;
+    }
+
+    option.conflicts.resize(n_conflicts);
+    for (Atom& conflict : option.conflicts)
+    {
+      read_atom(in, conflict);
+    }
+
+    quint32 n_dependencies = 0;
+    if (!read_count(in, n_dependencies))
+    {
+      return false;
+    }
+
+    option.dependencies.resize(n_dependencies);
+    for (Atom& dependency : option.dependencies)
+    {
+      read_atom(in, dependency);
+    }
+
+    object.options.push_back(std::move(option));
+  }
+
+  return in.status() == QDataStream::Ok;
+}
+
+static QByteArray hash_file(const QString& file_name)
+{
+  QFile file(file_name);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    return QByteArray();
+  }
+
+  return QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1);
+}
+
+
+SchemaCache::SchemaCache(const QString& file_name) :
+  file(file_name)
+{
+  load();
+}
+
+bool SchemaCache::find(const QFileInfo& file_info, ObjectSchema& schema)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  auto it = entries.find(file_info.absoluteFilePath());
+  if (it == entries.end())
+  {
+    return false;
+  }
+
+  Entry& entry = it->second;
+  const qint64 mtime = file_info.lastModified().toMSecsSinceEpoch();
+
+  // only hash the file if it was touched since the entry was made
+  if (entry.mtime != mtime || entry.size != file_info.size())
+  {
+    const QByteArray hash = entry.hash;
+
+    lock.unlock();
+    if (hash != hash_file(file_info.absoluteFilePath()))
+    {
+      return false;
+    }
+    lock.lock();
+
+    entry.mtime = mtime;
+    entry.size = file_info.size();
+    modified = true;
+  }
+
+  const QByteArray data = entry.data;
+  lock.unlock();
+
+  return deserialize(data, schema);
+}
+
+void SchemaCache::insert(const QFileInfo& file_info, const ObjectSchema& schema)
+{
+  Entry new_entry;
+  new_entry.mtime = file_info.lastModified().toMSecsSinceEpoch();
+  new_entry.size = file_info.size();
+  new_entry.hash = hash_file(file_info.absoluteFilePath());
+  new_entry.data = serialize(schema);
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  entries[file_info.absoluteFilePath()] = std::move(new_entry);
+  modified = true;
+}
+
+void SchemaCache::save()
+{
+  if (!modified)
+  {
+    return;
+  }
+
+  QByteArray index;
+  QDataStream index_out(&index, QIODevice::WriteOnly);
+  index_out.setVersion(QDataStream::Qt_5_0);
+
+  index_out << quint32(entries.size());
+
+  quint32 offset = 0;
+  for (const std::pair<const QString, Entry>& pair : entries)
+  {
+    const Entry& entry = pair.second;
+    index_out << pair.first << entry.mtime << entry.size << entry.hash << offset << quint32(entry.data.size());
+    offset += entry.data.size();
+  }
+
+  QDir().mkpath(QFileInfo(file.fileName()).absolutePath());
+
+  QSaveFile save_file(file.fileName());
+  if (!save_file.open(QIODevice::WriteOnly))
+  {
+    return;
+  }
+
+  QDataStream out(&save_file);
+  out << magic << version << quint32(index.size());
+  save_file.write(index);
+
+  for (const std::pair<const QString, Entry>& pair : entries)
+  {
+    save_file.write(pair.second.data);
+  }
+
+  // the old file stays mapped until the cache is destroyed, it's only unlinked by the rename
+  if (save_file.commit())
+  {
+    modified = false;
+  }
+}
+
+QString SchemaCache::default_file_name()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/objects.cache";
+}
+
+void SchemaCache::load()
+{
+  if (!file.open(QIODevice::ReadOnly) || file.size() < header_size)
+  {
+    return;
+  }
+
+  const qint64 size = file.size();
+  const char* map = reinterpret_cast<const char*>(file.map(0, size));
+  if (!map)
+  {
+    return;
+  }
+
+  QDataStream header(QByteArray::fromRawData(map, header_size));
+  quint32 file_magic = 0, file_version = 0, index_size = 0;
+  header >> file_magic >> file_version >> index_size;
+
+  // stale caches are simply rebuilt
+  if (file_magic != magic || file_version != version || header_size + index_size > size)
+  {
+    return;
+  }
+
+  QDataStream index(QByteArray::fromRawData(map + header_size, index_size));
+  index.setVersion(QDataStream::Qt_5_0);
+
+  const qint64 data_start = header_size + index_size;
+
+  quint32 n_entries = 0;
+  index >> n_entries;
+
+  for (quint32 i = 0; i < n_entries; i++)
+  {
+    QString file_name;
+    Entry entry;
+    quint32 offset = 0, length = 0;
+    index >> file_name >> entry.mtime >> entry.size >> entry.hash >> offset >> length;
+
+    if (index.status() != QDataStream::Ok || data_start + offset + length > size)
+    {
+      entries.clear();
+      return;
+    }
+
+    entry.data = QByteArray::fromRawData(map + data_start + offset, length);
+    entries.emplace(std::move(file_name), std::move(entry));
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SCHEMACACHE_H
+#define SCHEMACACHE_H
+
+#include "schema.h"
+
+#include <QFile>
+#include <QByteArray>
+
+#include <map>
+#include <mutex>
+
+class QFileInfo;
+
+/*
+ * Binary cache of the parsed yaml files, so they don't have to be parsed at every startup.
+ * Entries are keyed by the absolute file path and validated with the file's mtime, size
+ * and content hash. The cache file is memory mapped, the entries are only decoded when
+ * they are looked up.
+ * find and insert may be called from multiple threads.
+ */
+class SchemaCache
+{
+  struct Entry
+  {
+    qint64 mtime = 0;
+    qint64 size = 0;
+    QByteArray hash;
+    QByteArray data;  // serialized ObjectSchema, points into the mapped file when loaded from disk
+  };
+
+  QFile file;  // declared first, the mapping has to outlive the entries
+  std::map<QString, Entry> entries;
+  bool modified = false;
+  std::mutex mutex;
+
+public:
+  /*
+   * @file_name: the cache file, it's fine if it doesn't exist yet.
+   */
+  explicit SchemaCache(const QString& file_name);
+
+  /*
+   * @return: true if @file_info has a valid entry, @schema is filled from the entry.
+   */
+  bool find(const QFileInfo& file_info, ObjectSchema& schema);
+
+  /*
+   * Add or replace the entry of @file_info.
+   */
+  void insert(const QFileInfo& file_info, const ObjectSchema& schema);
+
+  /*
+   * Write the cache file, if any entry was added or replaced.
+   */
+  void save();
+
+  /*
+   * @return: the default location of the cache file.
+   */
+  static QString default_file_name();
+
+private:
+  void load();
+
+  // non copyable
+  SchemaCache(const SchemaCache&) = delete;
+  SchemaCache& operator=(const SchemaCache&) = delete;
+};
+
+#endif  // SCHEMACACHE_H
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "sink.h"
+
+#include <QIODevice>
+
+#include <charconv>
+
+Sink& Sink::operator<<(int number)
+{
+  char digits[16];
+  const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+  write(digits, result.ptr - digits);
+
+  return *this;
+}
+
+
+StringSink::StringSink(std::string& string) :
+  string(string)
+{}
+
+void StringSink::write(const char* data, std::size_t size)
+{
+  string.append(data, size);
+}
+
+
+BufferedSink::BufferedSink(std::size_t capacity)
+{
+  buffer.reserve(capacity);
+}
+
+void BufferedSink::write(const char* data, std::size_t size)
+{
+  if (buffer.size() + size > buffer.capacity())
+  {
+    flush();
+  }
+
+  // larger than the whole buffer, no point in copying it
+  if (size > buffer.capacity())
+  {
+    write_through(data, size);
+    return;
+  }
+
+  buffer.insert(buffer.end(), data, data + size);
+}
+
+void BufferedSink::flush()
+{
+  if (!buffer.empty())
+  {
+    write_through(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+}
+
+
+StreamSink::StreamSink(std::ostream& stream) :
+  stream(stream)
+{}
+
+StreamSink::~StreamSink()
+{
+  flush();
+}
+
+void StreamSink::flush()
+{
+  BufferedSink::flush();
+  stream.flush();
+}
+
+void StreamSink::write_through(const char* data, std::size_t size)
+{
+  stream.write(data, size);
+}
+
+
+DeviceSink::DeviceSink(QIODevice* device) :
+  device(device)
+{}
+
+DeviceSink::~DeviceSink()
+{
+  flush();
+}
+
+bool DeviceSink::has_failed() const
+{
+  return failed;
+}
+
+void DeviceSink::write_through(const char* data, std::size_t size)
+{
+  if (device->write(data, size) != static_cast<qint64>(size))
+  {
+    failed = true;
+  }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SINK_H
+#define SINK_H
+
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class QIODevice;
+
+/*
+ * Destination of the syslog-ng configuration written by the write() functions of the configuration elements.
+ * The pieces are appended one after the other, so no string of the whole configuration is built.
+ */
+class Sink
+{
+public:
+  virtual ~Sink() = default;
+
+  virtual void write(const char* data, std::size_t size) = 0;
+
+  Sink& operator<<(const std::string& text)
+  {
+    write(text.data(), text.size());
+    return *this;
+  }
+
+  Sink& operator<<(const char* text)
+  {
+    write(text, std::strlen(text));
+    return *this;
+  }
+
+  Sink& operator<<(char c)
+  {
+    write(&c, 1);
+    return *this;
+  }
+
+  Sink& operator<<(int number);
+
+  /*
+   * Passes on what the Sink holds back, for output that is read while it's being written, like a report.
+   */
+  virtual void flush() {}
+};
+
+/*
+ * Appends to a string, used for the cached output of the Objects and for to_string().
+ */
+class StringSink : public Sink
+{
+  std::string& string;
+
+public:
+  explicit StringSink(std::string& string);
+
+  void write(const char* data, std::size_t size);
+};
+
+/*
+ * Collects the pieces in a fixed size buffer, and passes it on with write_through() when it is full.
+ * The subclasses have to call flush() in their destructor, the buffer is lost otherwise.
+ */
+class BufferedSink : public Sink
+{
+  std::vector<char> buffer;
+
+public:
+  explicit BufferedSink(std::size_t capacity = 64 * 1024);
+
+  void write(const char* data, std::size_t size);
+
+  // passes on the buffer, the destination can be checked for errors after it
+  void flush();
+
+protected:
+  virtual void write_through(const char* data, std::size_t size) = 0;
+};
+
+/*
+ * Writes to a std::ostream, like std::cout.
+ */
+class StreamSink : public BufferedSink
+{
+  std::ostream& stream;
+
+public:
+  explicit StreamSink(std::ostream& stream);
+  ~StreamSink();
+
+  // flushes the stream too
+  void flush();
+
+protected:
+  void write_through(const char* data, std::size_t size);
+};
+
+/*
+ * Writes to an open QIODevice, like a QFile.
+ */
+class DeviceSink : public BufferedSink
+{
+  QIODevice* device;
+  bool failed = false;
+
+public:
+  explicit DeviceSink(QIODevice* device);
+  ~DeviceSink();
+
+  /*
+   * @return: returns true if any of the writes to the device failed so far.
+   */
+  bool has_failed() const;
+
+protected:
+  void write_through(const char* data, std::size_t size);
+};
+
+#endif  // SINK_H
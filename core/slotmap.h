@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+/*
+ * Container with O(1) insert, lookup and erase through generational handles.
+ * An erased element's slot is reused, but with a new generation,
+ * so the handles of erased elements never find the new element.
+ * The elements are allocated one by one with @Allocator and never move,
+ * iteration is in insertion order.
+ */
+template<typename T, typename Allocator = std::allocator<T> >
+class SlotMap
+{
+public:
+  struct Handle
+  {
+    std::uint32_t index;
+    std::uint32_t generation;
+  };
+
+private:
+  static const std::uint32_t npos = UINT32_MAX;
+
+  /*
+   * An occupied entry is linked to its neighbours in insertion order,
+   * a free entry is linked to the next free entry through @next.
+   */
+  struct Entry
+  {
+    T* value = nullptr;
+    std::uint32_t generation = 0;
+    std::uint32_t previous = npos;
+    std::uint32_t next = npos;
+  };
+
+  std::vector<Entry> entries;
+  std::uint32_t first = npos;
+  std::uint32_t last = npos;
+  std::uint32_t first_free = npos;
+  std::size_t count = 0;
+  Allocator allocator;
+
+public:
+  template<typename Value>
+  class Iterator
+  {
+    const std::vector<Entry>* entries;
+    std::uint32_t index;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    Iterator(const std::vector<Entry>* entries, std::uint32_t index) :
+      entries(entries),
+      index(index)
+    {}
+
+    Value& operator*() const { return *(*entries)[index].value; }
+    Value* operator->() const { return (*entries)[index].value; }
+
+    Iterator& operator++()
+    {
+      index = (*entries)[index].next;
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      Iterator it = *this;
+      ++*this;
+      return it;
+    }
+
+    bool operator==(const Iterator& other) const { return index == other.index; }
+    bool operator!=(const Iterator& other) const { return index != other.index; }
+  };
+
+  typedef Iterator<T> iterator;
+  typedef Iterator<const T> const_iterator;
+
+  explicit SlotMap(const Allocator& allocator = Allocator()) :
+    allocator(allocator)
+  {}
+
+  ~SlotMap()
+  {
+    clear();
+  }
+
+  /*
+   * Construct a new element from @args.
+   * @return: returns the handle of the new element.
+   */
+  template<typename... Args>
+  Handle emplace(Args&&... args)
+  {
+    // the entry is reserved first, nothing can throw once the element is constructed
+    if (first_free == npos)
+    {
+      entries.emplace_back();
+      first_free = entries.size() - 1;
+    }
+
+    T* value = std::allocator_traits<Allocator>::allocate(allocator, 1);
+    try
+    {
+      std::allocator_traits<Allocator>::construct(allocator, value, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      std::allocator_traits<Allocator>::deallocate(allocator, value, 1);
+      throw;
+    }
+
+    const std::uint32_t index = first_free;
+    first_free = entries[index].next;
+
+    Entry& entry = entries[index];
+    entry.value = value;
+    entry.previous = last;
+    entry.next = npos;
+
+    (last == npos ? first : entries[last].next) = index;
+    last = index;
+    count++;
+
+    return Handle{index, entry.generation};
+  }
+
+  /*
+   * @return: returns the element of @handle, nullptr if it was erased.
+   */
+  T* find(Handle handle) const
+  {
+    if (handle.index >= entries.size() || entries[handle.index].generation != handle.generation)
+    {
+      return nullptr;
+    }
+
+    return entries[handle.index].value;
+  }
+
+  /*
+   * Destroy the element of @handle.
+   * @return: returns false if it was already erased.
+   */
+  bool erase(Handle handle)
+  {
+    T* value = find(handle);
+    if (!value)
+    {
+      return false;
+    }
+
+    Entry& entry = entries[handle.index];
+    (entry.previous == npos ? first : entries[entry.previous].next) = entry.next;
+    (entry.next == npos ? last : entries[entry.next].previous) = entry.previous;
+
+    entry.value = nullptr;
+    entry.generation++;
+    entry.next = first_free;
+    first_free = handle.index;
+    count--;
+
+    // unlinked first, the destructor may erase other elements
+    std::allocator_traits<Allocator>::destroy(allocator, value);
+    std::allocator_traits<Allocator>::deallocate(allocator, value, 1);
+
+    return true;
+  }
+
+  void clear()
+  {
+    while (first != npos)
+    {
+      erase(Handle{first, entries[first].generation});
+    }
+  }
+
+  const Allocator& get_allocator() const { return allocator; }
+
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  iterator begin() { return iterator(&entries, first); }
+  iterator end() { return iterator(&entries, npos); }
+  const_iterator begin() const { return const_iterator(&entries, first); }
+  const_iterator end() const { return const_iterator(&entries, npos); }
+
+private:
+  // non copyable
+  SlotMap(const SlotMap&) = delete;
+  SlotMap& operator=(const SlotMap&) = delete;
+};
+
+#endif  // SLOTMAP_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "statementindex.h"
+#include "object.h"
+
+const std::vector<const LogStatement*>& StatementIndex::get_log_statements(const ObjectStatement& object_statement) const
+{
+  return log_statements.get(&object_statement);
+}
+
+std::size_t StatementIndex::count_log_statements(const ObjectStatement& object_statement) const
+{
+  return log_statements.count(&object_statement);
+}
+
+const std::vector<const ObjectStatement*>& StatementIndex::get_object_statements(const Object& object) const
+{
+  return object_statements.get(&object);
+}
+
+std::size_t StatementIndex::count_object_statements(const Object& object) const
+{
+  return object_statements.count(&object);
+}
+
+const ObjectStatement* StatementIndex::find_object_statement(const std::string& id) const
+{
+  auto it = ids.find(id);
+  return it == ids.end() ? nullptr : it->second;
+}
+
+void StatementIndex::add_object_statement(const ObjectStatement& object_statement)
+{
+  ids.emplace(object_statement.get_id(), &object_statement);
+}
+
+void StatementIndex::remove_object_statement(const ObjectStatement& object_statement)
+{
+  auto range = ids.equal_range(object_statement.get_id());
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == &object_statement)
+    {
+      ids.erase(it);
+      return;
+    }
+  }
+}
+
+void StatementIndex::link(const ObjectStatement& object_statement, const LogStatement& log_statement)
+{
+  log_statements.add(&object_statement, &log_statement);
+}
+
+void StatementIndex::unlink(const ObjectStatement& object_statement, const LogStatement& log_statement)
+{
+  log_statements.remove(&object_statement, &log_statement);
+}
+
+void StatementIndex::link(const Object& object, const ObjectStatement& object_statement)
+{
+  object_statements.add(&object, &object_statement);
+}
+
+void StatementIndex::unlink(const Object& object, const ObjectStatement& object_statement)
+{
+  object_statements.remove(&object, &object_statement);
+}
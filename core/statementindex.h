@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef STATEMENTINDEX_H
+#define STATEMENTINDEX_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Object;
+class ObjectStatement;
+class LogStatement;
+
+/*
+ * Unordered adjacency lists of a many to many relation, from @From nodes to @To nodes.
+ * Adding and removing an edge and counting the neighbours of a node are O(1):
+ * each edge knows its position in its list, a removed edge is replaced by the last one.
+ */
+template<typename From, typename To>
+class Adjacency
+{
+  typedef std::pair<const From*, const To*> Edge;
+
+  struct EdgeHash
+  {
+    std::size_t operator()(const Edge& edge) const
+    {
+      const std::size_t from = std::hash<const From*>()(edge.first);
+      return from ^ (std::hash<const To*>()(edge.second) + 0x9e3779b9 + (from << 6) + (from >> 2));
+    }
+  };
+
+  std::unordered_map< const From*, std::vector<const To*> > lists;
+  std::unordered_map<Edge, std::size_t, EdgeHash> positions;
+
+public:
+  /*
+   * @return: returns false if the edge is already there.
+   */
+  bool add(const From* from, const To* to)
+  {
+    auto inserted = positions.emplace(Edge(from, to), 0);
+    if (!inserted.second)
+    {
+      return false;
+    }
+
+    std::vector<const To*>& list = lists[from];
+    inserted.first->second = list.size();
+    list.push_back(to);
+
+    return true;
+  }
+
+  /*
+   * @return: returns false if the edge is not there.
+   */
+  bool remove(const From* from, const To* to)
+  {
+    auto it = positions.find(Edge(from, to));
+    if (it == positions.end())
+    {
+      return false;
+    }
+
+    const std::size_t position = it->second;
+    positions.erase(it);
+
+    auto list = lists.find(from);
+    list->second[position] = list->second.back();
+    list->second.pop_back();
+
+    if (position < list->second.size())
+    {
+      positions[Edge(from, list->second[position])] = position;
+    }
+
+    if (list->second.empty())
+    {
+      lists.erase(list);
+    }
+
+    return true;
+  }
+
+  /*
+   * @return: returns the neighbours of @from, in no particular order.
+   */
+  const std::vector<const To*>& get(const From* from) const
+  {
+    static const std::vector<const To*> none;
+
+    auto list = lists.find(from);
+    return list == lists.end() ? none : list->second;
+  }
+
+  std::size_t count(const From* from) const
+  {
+    auto list = lists.find(from);
+    return list == lists.end() ? 0 : list->second.size();
+  }
+};
+
+/*
+ * Cross references of the configuration elements, kept up to date by the statements as they change,
+ * so the editor, the linter and the serializers don't have to scan every LogStatement:
+ * which LogStatements hold an ObjectStatement, which ObjectStatements hold an Object,
+ * and the ObjectStatements by id.
+ * The other direction is held by the statements themselves, see get_objects and get_object_statements.
+ */
+class StatementIndex
+{
+  Adjacency<ObjectStatement, LogStatement> log_statements;
+  Adjacency<Object, ObjectStatement> object_statements;
+  std::unordered_multimap<std::string, const ObjectStatement*> ids;
+
+public:
+  /*
+   * @return: returns the LogStatements holding @object_statement, in no particular order.
+   */
+  const std::vector<const LogStatement*>& get_log_statements(const ObjectStatement& object_statement) const;
+
+  /*
+   * @return: returns the number of LogStatements holding @object_statement, 0 if it's unused.
+   */
+  std::size_t count_log_statements(const ObjectStatement& object_statement) const;
+
+  /*
+   * @return: returns the ObjectStatements holding @object, in no particular order.
+   */
+  const std::vector<const ObjectStatement*>& get_object_statements(const Object& object) const;
+
+  std::size_t count_object_statements(const Object& object) const;
+
+  /*
+   * @return: returns an ObjectStatement with @id, nullptr if there is none.
+   */
+  const ObjectStatement* find_object_statement(const std::string& id) const;
+
+private:
+  // called by the statements only
+  friend class ObjectStatement;
+  friend class LogStatement;
+
+  void add_object_statement(const ObjectStatement& object_statement);
+  void remove_object_statement(const ObjectStatement& object_statement);
+
+  void link(const ObjectStatement& object_statement, const LogStatement& log_statement);
+  void unlink(const ObjectStatement& object_statement, const LogStatement& log_statement);
+
+  void link(const Object& object, const ObjectStatement& object_statement);
+  void unlink(const Object& object, const ObjectStatement& object_statement);
+};
+
+#endif  // STATEMENTINDEX_H
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "validator.h"
+#include "config.h"
+#include "sink.h"
+
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QRunnable>
+#include <QTemporaryFile>
+#include <QDir>
+
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+  // how often a running check looks at whether it's stale
+  const int poll_interval = 50;
+
+  class ValidationJob : public QRunnable
+  {
+    const std::atomic<std::uint64_t>& latest;
+    const std::uint64_t sequence;
+    const std::string hash;
+    const std::string text;
+    const QString program;
+    const QStringList arguments;
+    const int timeout;
+
+  public:
+    // called with the result in the worker thread
+    std::function<void(const ValidationResult&)> done;
+
+    ValidationJob(const std::atomic<std::uint64_t>& latest, std::uint64_t sequence,
+                  const std::string& hash, const std::string& text,
+                  const QString& program, const QStringList& arguments, int timeout) :
+      latest(latest),
+      sequence(sequence),
+      hash(hash),
+      text(text),
+      program(program),
+      arguments(arguments),
+      timeout(timeout)
+    {}
+
+    void run()
+    {
+      ValidationResult result = check();
+      done(result);
+    }
+
+  private:
+    bool is_stale() const
+    {
+      return latest.load() != sequence;
+    }
+
+    ValidationResult check() const
+    {
+      ValidationResult result;
+      if (is_stale())
+      {
+        result.status = ValidationStatus::CANCELED;
+        return result;
+      }
+
+      QTemporaryFile file(QDir::tempPath() + "/syslog-ng-config-XXXXXX.conf");
+      if (!file.open() || file.write(text.data(), text.size()) != qint64(text.size()) || !file.flush())
+      {
+        result.message = "can't write the temporary configuration file";
+        return result;
+      }
+
+      return run_validator(program, arguments, file.fileName(), timeout, [this]() {
+        return is_stale();
+      });
+    }
+  };
+}
+
+ValidationResult run_validator(const QString& program, const QStringList& arguments, const QString& file_name,
+                               int timeout, const std::function<bool()>& canceled)
+{
+  ValidationResult result;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  QProcess process;
+  process.start(program, QStringList(arguments) << file_name);
+  if (!process.waitForStarted())
+  {
+    result.message = "can't start " + program.toStdString();
+    return result;
+  }
+
+  while (!process.waitForFinished(poll_interval))
+  {
+    const bool is_canceled = canceled && canceled();
+    if (is_canceled || timer.elapsed() > timeout)
+    {
+      result.status = is_canceled ? ValidationStatus::CANCELED : ValidationStatus::TIMED_OUT;
+      process.kill();
+      process.waitForFinished();
+      result.milliseconds = timer.elapsed();
+      return result;
+    }
+  }
+
+  result.milliseconds = timer.elapsed();
+  result.status = process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0 ?
+    ValidationStatus::VALID : ValidationStatus::INVALID;
+  result.message = process.readAllStandardError().toStdString();
+
+  return result;
+}
+
+
+Validator::Validator(QObject* parent) :
+  QObject(parent)
+{
+  pool.setMaxThreadCount(2);
+
+  debounce_timer.setSingleShot(true);
+  debounce_timer.setInterval(500);
+
+  connect(&debounce_timer, &QTimer::timeout, [this]() {
+    if (pending_config)
+    {
+      validate_now(*pending_config);
+    }
+  });
+}
+
+Validator::~Validator()
+{
+  // the running checks see that they are stale and kill their process
+  pool.clear();
+  latest++;
+  pool.waitForDone();
+}
+
+void Validator::set_program(const QString& program, const QStringList& arguments)
+{
+  this->program = program;
+  this->arguments = arguments;
+}
+
+void Validator::set_max_threads(int max_threads)
+{
+  pool.setMaxThreadCount(max_threads);
+}
+
+void Validator::set_debounce(int milliseconds)
+{
+  debounce_timer.setInterval(milliseconds);
+}
+
+void Validator::set_timeout(int milliseconds)
+{
+  timeout = milliseconds;
+}
+
+void Validator::validate(const Config& config)
+{
+  pending_config = &config;
+  debounce_timer.start();
+}
+
+void Validator::validate_now(const Config& config)
+{
+  debounce_timer.stop();
+  pending_config = nullptr;
+
+  std::string text;
+  {
+    StringSink sink(text);
+    config.write(sink);
+  }
+
+  start(text);
+}
+
+const Validator::Statistics& Validator::get_statistics() const
+{
+  return statistics;
+}
+
+void Validator::start(const std::string& text)
+{
+  const QByteArray digest = QCryptographicHash::hash(QByteArray::fromRawData(text.data(), text.size()), QCryptographicHash::Sha1);
+  const std::string hash(digest.constData(), digest.size());
+
+  // the same text is being checked already
+  if (latest_running && hash == latest_hash)
+  {
+    return;
+  }
+
+  const std::uint64_t sequence = ++latest;
+  latest_hash = hash;
+
+  // only the latest request counts, the waiting ones are dropped
+  pool.clear();
+
+  auto cached = cache.find(hash);
+  if (cached != cache.end())
+  {
+    latest_running = false;
+    statistics.cache_hits++;
+
+    ValidationResult result = cached->second;
+    result.cached = true;
+    emit validated(result);
+    return;
+  }
+
+  latest_running = true;
+
+  ValidationJob* job = new ValidationJob(latest, sequence, hash, text, program, arguments, timeout);
+  job->done = [this, sequence, hash](const ValidationResult& result) {
+    // back in the thread of the Validator, dropped if it's destroyed by then
+    QMetaObject::invokeMethod(this, [this, sequence, hash, result]() {
+      finish(sequence, hash, result);
+    }, Qt::QueuedConnection);
+  };
+
+  pool.start(job);
+}
+
+void Validator::finish(std::uint64_t sequence, const std::string& hash, const ValidationResult& result)
+{
+  if (result.status == ValidationStatus::CANCELED)
+  {
+    statistics.canceled++;
+    return;
+  }
+
+  if (result.status != ValidationStatus::NOT_STARTED)
+  {
+    statistics.runs++;
+    statistics.total_milliseconds += result.milliseconds;
+    statistics.max_milliseconds = std::max(statistics.max_milliseconds, result.milliseconds);
+  }
+
+  // a timeout or a missing validator can be different next time
+  if (result.status == ValidationStatus::VALID || result.status == ValidationStatus::INVALID)
+  {
+    cache.emplace(hash, result);
+  }
+
+  if (sequence != latest.load())
+  {
+    return;
+  }
+
+  latest_running = false;
+  emit validated(result);
+}
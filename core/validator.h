@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+
+#include <QObject>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+class Config;
+
+enum class ValidationStatus { VALID, INVALID, TIMED_OUT, NOT_STARTED, CANCELED };
+
+struct ValidationResult
+{
+  ValidationStatus status = ValidationStatus::NOT_STARTED;
+  std::string message;  // what the validator printed, the syntax errors
+  qint64 milliseconds = 0;
+  bool cached = false;
+};
+
+/*
+ * Runs "@program @arguments @file_name" in the calling thread and waits for it, killing it after @timeout milliseconds.
+ * @canceled: polled while the validator runs, it's killed as soon as true is returned, nullptr for never.
+ */
+ValidationResult run_validator(const QString& program, const QStringList& arguments, const QString& file_name,
+                               int timeout, const std::function<bool()>& canceled = nullptr);
+
+/*
+ * Checks the syntax of the configuration with "syslog-ng -s -f FILE" on a worker pool, off the GUI thread.
+ * Only the latest request counts: waiting requests are dropped, running ones are killed.
+ * The results are cached by the hash of the configuration text, the same text is never checked twice.
+ */
+class Validator : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Statistics
+  {
+    unsigned int runs = 0;
+    unsigned int cache_hits = 0;
+    unsigned int canceled = 0;
+    qint64 total_milliseconds = 0;
+    qint64 max_milliseconds = 0;
+  };
+
+private:
+  QString program = "syslog-ng";
+  QStringList arguments { "-s", "-f" };
+  int timeout = 10000;
+
+  QThreadPool pool;
+  QTimer debounce_timer;
+  const Config* pending_config = nullptr;
+
+  // of the latest request, a job of an earlier one is stale
+  std::atomic<std::uint64_t> latest { 0 };
+  std::string latest_hash;
+  bool latest_running = false;
+
+  std::unordered_map<std::string, ValidationResult> cache;
+  Statistics statistics;
+
+public:
+  explicit Validator(QObject* parent = 0);
+  ~Validator();
+
+  /*
+   * @program, @arguments: the validator, the name of the configuration file is appended to the arguments.
+   */
+  void set_program(const QString& program, const QStringList& arguments);
+
+  void set_max_threads(int max_threads);
+  void set_debounce(int milliseconds);
+  void set_timeout(int milliseconds);
+
+  /*
+   * Validates @config when it has not changed for the debounce interval.
+   * @config: has to outlive the Validator.
+   */
+  void validate(const Config& config);
+
+  /*
+   * Validates @config right away, the result can come before returning, if it's cached.
+   */
+  void validate_now(const Config& config);
+
+  const Statistics& get_statistics() const;
+
+signals:
+  /*
+   * Emitted in the thread of the Validator, only for the latest request.
+   */
+  void validated(const ValidationResult& result);
+
+private:
+  void start(const std::string& text);
+  void finish(std::uint64_t sequence, const std::string& hash, const ValidationResult& result);
+
+  // non copyable
+  Validator(const Validator&) = delete;
+  Validator& operator=(const Validator&) = delete;
+};
+
+#endif  // VALIDATOR_H
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Build time tool, compiles the yaml files into C++ tables of BuiltinObjects,
+ * so the default Objects can be created without reading any file.
+ *
+ * usage: schemagen OUTPUT INPUT...
+ */
+
+#include "schema.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <regex>
+
+/*
+ * @return: returns @string as a C++ string literal.
+ */
+std::string quote(const std::string& string)
+{
+  std::string literal = "\"";
+
+  for (const char c : string)
+  {
+    switch (c)
+    {
+      case '"': literal += "\\\""; break;
+      case '\\': literal += "\\\\"; break;
+      case '?': literal += "\\?"; break;  // no trigraphs
+      case '\n': literal += "\\n"; break;
+      case '\t': literal += "\\t"; break;
+      default: literal += c;
+    }
+  }
+
+  literal += "\"";
+
+  return literal;
+}
+
+/*
+ * @return: returns the enumerator of @type, so the tables need no lookup by name.
+ */
+std::string enumerator(ObjectType type)
+{
+  static const char* const names[] = { "SOURCE", "DESTINATION", "FILTER", "TEMPLATE", "REWRITE", "PARSER", "OPTIONS" };
+  return std::string("ObjectType::") + names[static_cast<int>(type)];
+}
+
+std::string enumerator(OptionType type)
+{
+  static const char* const names[] = { "STRING", "NUMBER", "LIST", "SET", "OPTIONS" };
+  return std::string("OptionType::") + names[static_cast<int>(type)];
+}
+
+/*
+ * Writes @atoms as a C++ array named @name, nothing if @atoms is empty.
+ */
+void write_atoms(std::ostream& out, const std::string& name, const std::vector<Atom>& atoms)
+{
+  if (atoms.empty())
+  {
+    return;
+  }
+
+  out << "constexpr const char* " << name << "[] = {";
+  for (const Atom& atom : atoms)
+  {
+    out << "\n  " << quote(atom.str()) << ",";
+  }
+  out << "\n};\n\n";
+}
+
+/*
+ * Writes the pointer and size of the @name array of @atoms, see write_atoms.
+ */
+void write_atoms_ref(std::ostream& out, const std::string& name, const std::vector<Atom>& atoms)
+{
+  if (atoms.empty())
+  {
+    out << "nullptr, 0";
+  }
+  else
+  {
+    out << name << ", " << atoms.size();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "usage: " << argv[0] << " OUTPUT INPUT..." << std::endl;
+    return 1;
+  }
+
+  // sorted, so the output doesn't depend on the order of the arguments
+  std::vector<std::string> file_names(argv + 2, argv + argc);
+  std::sort(file_names.begin(), file_names.end());
+
+  std::vector<ObjectSchema> objects;
+  for (const std::string& file_name : file_names)
+  {
+    try
+    {
+      objects.push_back(read_schema(file_name));
+
+      // a broken pattern fails the build instead of the application
+      for (const OptionSchema& option : objects.back().options)
+      {
+        if (!option.pattern.empty())
+        {
+          std::regex(option.pattern, std::regex::ECMAScript);
+        }
+      }
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << file_name << ": " << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  std::ofstream out(argv[1]);
+
+  out << "// Generated by schemagen from the objects directory, do not edit.\n\n";
+  out << "#include \"schema.h\"\n\n";
+  out << "namespace {\n\n";
+
+  for (std::size_t i = 0; i < objects.size(); i++)
+  {
+    const ObjectSchema& object = objects[i];
+
+    for (std::size_t j = 0; j < object.options.size(); j++)
+    {
+      const OptionSchema& option = object.options[j];
+      const std::string prefix = "object_" + std::to_string(i) + "_option_" + std::to_string(j);
+
+      write_atoms(out, prefix + "_values", option.values);
+      write_atoms(out, prefix + "_conflicts", option.conflicts);
+      write_atoms(out, prefix + "_dependencies", option.dependencies);
+    }
+
+    if (object.options.empty())
+    {
+      continue;
+    }
+
+    out << "constexpr BuiltinOption object_" << i << "_options[] = {";
+    for (std::size_t j = 0; j < object.options.size(); j++)
+    {
+      const OptionSchema& option = object.options[j];
+
+      out << "\n  { " << quote(option.name.str()) << ", " << quote(option.type.str()) << ", " << enumerator(option.option_type) << ", "
+          << quote(option.description) << ", ";
+
+      const std::string prefix = "object_" + std::to_string(i) + "_option_" + std::to_string(j);
+
+      write_atoms_ref(out, prefix + "_values", option.values);
+      out << ", " << (option.has_default ? quote(option.default_value) : "nullptr") << ", ";
+      out << (option.required ? "true" : "false") << ", ";
+      out << option.minimum << ", " << option.maximum << ", ";
+      out << (option.pattern.empty() ? "nullptr" : quote(option.pattern)) << ", ";
+      out << (option.path ? "true" : "false") << ", ";
+      write_atoms_ref(out, prefix + "_conflicts", option.conflicts);
+      out << ", ";
+      write_atoms_ref(out, prefix + "_dependencies", option.dependencies);
+      out << " },";
+    }
+    out << "\n};\n\n";
+  }
+
+  out << "}  // namespace\n\n";
+
+  out << "extern const BuiltinObject builtin_objects[] = {";
+  for (std::size_t i = 0; i < objects.size(); i++)
+  {
+    const ObjectSchema& object = objects[i];
+
+    out << "\n  { " << quote(object.name.str()) << ", " << quote(object.type.str()) << ", " << enumerator(object.object_type) << ", "
+        << quote(object.description) << ", ";
+
+    if (object.options.empty())
+    {
+      out << "nullptr, 0 },";
+    }
+    else
+    {
+      out << "object_" << i << "_options, " << object.options.size() << " },";
+    }
+  }
+  out << "\n};\n\n";
+
+  out << "extern const std::size_t n_builtin_objects = " << objects.size() << ";\n";
+
+  out.close();
+  if (!out)
+  {
+    std::cerr << argv[1] << ": cannot write file" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
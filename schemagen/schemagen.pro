@@ -0,0 +1,17 @@
+TEMPLATE = app
+CONFIG += c++17 console
+CONFIG -= qt app_bundle
+TARGET = schemagen
+INCLUDEPATH += ../core
+OBJECTS_DIR = ../build/schemagen
+LIBS += -lyaml-cpp
+
+SOURCES += \
+    ../core/atom.cpp \
+    ../core/schema.cpp \
+    main.cpp
+
+HEADERS += \
+    ../core/atom.h \
+    ../core/schema.h
+
@@ -21,14 +21,230 @@
 #include "dialog.h"
 #include "ui_dialog.h"
 #include "object.h"
+#include "constraints.h"
 
 #include <QGroupBox>
 #include <QAbstractButton>
+#include <QVBoxLayout>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QPushButton>
+
+#include <limits>
+#include <functional>
+
+namespace
+{
+  // the widgets of each option type, the model itself knows nothing about them
+
+  void create_option_form(Option& option, QVBoxLayout* vboxLayout)
+  {
+    const OptionSchema& schema = option.get_schema();
+
+    switch (option.get_type())
+    {
+      case OptionType::STRING:
+      {
+        QLineEdit* lineEdit = new QLineEdit;
+        vboxLayout->addWidget(lineEdit);
+        break;
+      }
+      case OptionType::NUMBER:
+      {
+        QSpinBox* spinBox = new QSpinBox;
+        spinBox->setRange(-1, std::numeric_limits<int>::max());
+        spinBox->setSpecialValueText(" ");
+        vboxLayout->addWidget(spinBox);
+        break;
+      }
+      case OptionType::LIST:
+      {
+        QComboBox* comboBox = new QComboBox;
+        for (const Atom& value : schema.values)
+        {
+          comboBox->addItem(QString::fromStdString(value.str()));
+        }
+        vboxLayout->addWidget(comboBox);
+        break;
+      }
+      case OptionType::SET:
+      {
+        for (const Atom& value : schema.values)
+        {
+          QCheckBox* checkBox = new QCheckBox(QString::fromStdString(value.str()));
+          vboxLayout->addWidget(checkBox);
+        }
+        break;
+      }
+      case OptionType::OPTIONS:
+      {
+        QPushButton* button = new QPushButton(QString::fromStdString("set " + schema.type.str() + " options"));
+        vboxLayout->addWidget(button);
+
+        Dialog* dialog = new Dialog(option.get_options(), vboxLayout->parentWidget());
+        QObject::connect(button, &QPushButton::clicked, dialog, &Dialog::exec);
+        break;
+      }
+    }
+  }
+
+  /*
+   * Calls @changed whenever a widget of @groupBox is edited.
+   */
+  void connect_option_form(QGroupBox* groupBox, const std::function<void()>& changed)
+  {
+    // not the line edit inside the spinbox
+    for (QLineEdit* lineEdit : groupBox->findChildren<QLineEdit*>(QString(), Qt::FindDirectChildrenOnly))
+    {
+      QObject::connect(lineEdit, &QLineEdit::textChanged, changed);
+    }
+
+    for (QSpinBox* spinBox : groupBox->findChildren<QSpinBox*>())
+    {
+      QObject::connect(spinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), changed);
+    }
+
+    for (QComboBox* comboBox : groupBox->findChildren<QComboBox*>())
+    {
+      QObject::connect(comboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), changed);
+    }
+
+    for (QCheckBox* checkBox : groupBox->findChildren<QCheckBox*>())
+    {
+      QObject::connect(checkBox, &QCheckBox::toggled, changed);
+    }
+  }
+
+  void set_option_form_value(const Option& option, QGroupBox* groupBox)
+  {
+    const Option::Values& values = option.get_values();
+
+    switch (option.get_type())
+    {
+      case OptionType::STRING:
+      {
+        QLineEdit* lineEdit = groupBox->findChild<QLineEdit*>();
+        lineEdit->setText(QString::fromStdString(std::get<StringValues>(values).current_value));
+        break;
+      }
+      case OptionType::NUMBER:
+      {
+        QSpinBox* spinBox = groupBox->findChild<QSpinBox*>();
+        spinBox->setValue(std::get<NumberValues>(values).current_value);
+        break;
+      }
+      case OptionType::LIST:
+      {
+        QComboBox* comboBox = groupBox->findChild<QComboBox*>();
+        comboBox->setCurrentIndex(std::get<ListValues>(values).current_value);
+        break;
+      }
+      case OptionType::SET:
+      {
+        const std::string& current_value = std::get<SetValues>(values).current_value;
+
+        QList<QCheckBox*> checkBoxes = groupBox->findChildren<QCheckBox*>();
+        for (QCheckBox* checkBox : checkBoxes)
+        {
+          std::string value = checkBox->text().toStdString();
+          current_value.find(value) == std::string::npos ? checkBox->setChecked(false) : checkBox->setChecked(true);
+        }
+        break;
+      }
+      case OptionType::OPTIONS:
+        break;
+    }
+  }
+
+  /*
+   * @return: false if the option is required, but it's not set in @groupBox.
+   */
+  bool set_option_from_form(Option& option, QGroupBox* groupBox)
+  {
+    const Option::Values& values = option.get_values();
+
+    switch (option.get_type())
+    {
+      case OptionType::STRING:
+      {
+        QLineEdit* lineEdit = groupBox->findChild<QLineEdit*>();
+        option.edit_current(lineEdit->text().toStdString());
+
+        return !(option.is_required() && std::get<StringValues>(values).current_value.empty());
+      }
+      case OptionType::NUMBER:
+      {
+        QSpinBox* spinBox = groupBox->findChild<QSpinBox*>();
+        option.edit_current(std::to_string(spinBox->value()));
+
+        return !(option.is_required() && std::get<NumberValues>(values).current_value == -1);
+      }
+      case OptionType::LIST:
+      {
+        QComboBox* comboBox = groupBox->findChild<QComboBox*>();
+        option.edit_current(comboBox->currentText().toStdString());
+
+        return !(option.is_required() && std::get<ListValues>(values).current_value == -1);
+      }
+      case OptionType::SET:
+      {
+        std::string new_value;
+
+        // quirks
+        static const Atom scope("scope");
+        std::string sep = (option.get_schema().name == scope ? " " : ", ");
+
+        QList<QCheckBox*> checkBoxes = groupBox->findChildren<QCheckBox*>();
+        for (QCheckBox* checkBox : checkBoxes)
+        {
+          if (checkBox->isChecked())
+          {
+            std::string value = checkBox->text().toStdString();
+            new_value += (new_value.empty() ? "" : sep) + value;
+          }
+        }
+
+        option.edit_current(new_value);
+
+        return !(option.is_required() && std::get<SetValues>(values).current_value.empty());
+      }
+      case OptionType::OPTIONS:
+        return true;
+    }
+
+    return true;
+  }
+
+  /*
+   * Copies the values of the options of @from that are written differently than those of @to,
+   * nested Options in place, so the dialogs of the nested Options stay valid.
+   */
+  void copy_changed_options(const Object& from, Object& to)
+  {
+    for (std::size_t i = 0; i < from.get_options().size(); i++)
+    {
+      const Option& source = from.get_options()[i];
+      Option& target = to.get_options()[i];
+
+      if (target.get_type() == OptionType::OPTIONS)
+      {
+        copy_changed_options(source.get_options(), target.get_options());
+      }
+      else if (target.get_current_value() != source.get_current_value())
+      {
+        target.set_values(source);
+      }
+    }
+  }
+}
 
 Dialog::Dialog(Object& object, QWidget* parent) :
   QDialog(parent),
   ui(new Ui::Dialog),
-  object(object)
+  object(object),
+  scratch(object.clone())
 {
   ui->setupUi(this);
 
@@ -41,9 +257,9 @@ Dialog::Dialog(Object& object, QWidget* parent) :
   connect(ui->buttonBox, &QDialogButtonBox::clicked, [&](QAbstractButton* button) {
     if (ui->buttonBox->standardButton(button) == QDialogButtonBox::RestoreDefaults)
     {
-      for (std::unique_ptr<Option>& option : object.get_options())
+      for (Option& option : scratch->get_options())
       {
-        option->restore_default();
+        option.restore_default();
       }
 
       set_form_values();
@@ -58,6 +274,8 @@ Dialog::~Dialog()
 
 int Dialog::exec()
 {
+  // a dialog can be executed more than once, like those of nested Options, which may have changed meanwhile
+  copy_changed_options(object, *scratch);
   set_form_values();
 
   return QDialog::exec();
@@ -65,41 +283,45 @@ int Dialog::exec()
 
 void Dialog::accept()
 {
-  if (set_object_options())  // dialog remains open if there are empty required options
+  if (!set_object_options())  // dialog remains open if there are empty required options
   {
-    for (std::unique_ptr<Option>& option : object.get_options())
-    {
-      option->set_previous();
-    }
-
-    QDialog::accept();
+    return;
   }
-}
 
-void Dialog::reject()
-{
-  for (std::unique_ptr<Option>& option : object.get_options())
+  if (QGroupBox* groupBox = check_options())  // or violated constraints
   {
-    option->restore_previous();
+    ui->scrollArea->ensureWidgetVisible(groupBox);
+    groupBox->setFocus();
+    return;
   }
 
-  QDialog::reject();
+  // only the changed options count as an edit of the configuration
+  copy_changed_options(*scratch, object);
+
+  QDialog::accept();
 }
 
 void Dialog::create_form()
 {
   QFormLayout* formLayout = findChild<QFormLayout*>();
 
-  for (const std::unique_ptr<Option>& option : object.get_options())
+  for (Option& option : scratch->get_options())
   {
-    const std::string name = (option->is_required() ? "* " : "") + option->get_name();
+    const std::string name = (option.is_required() ? "* " : "") + option.get_name();
     QGroupBox* groupBox = new QGroupBox(QString::fromStdString(name));
-    groupBox->setToolTip(QString::fromStdString(option->get_description()));
+    groupBox->setToolTip(QString::fromStdString(option.get_description()));
 
     QVBoxLayout* vboxLayout = new QVBoxLayout(groupBox);
-    option->create_form(vboxLayout);
+    create_option_form(option, vboxLayout);
+
+    // the edits go to the copy right away, so its constraints can be checked without changing the configuration
+    connect_option_form(groupBox, [this, &option, groupBox]() {
+      set_option_from_form(option, groupBox);
+      check_options();
+    });
 
     formLayout->addRow(groupBox);
+    groupBoxes.push_back(groupBox);
   }
 }
 
@@ -109,10 +331,10 @@ void Dialog::set_form_values()
   QList<QGroupBox*> groupBoxes = parent->findChildren<QGroupBox*>(QString(), Qt::FindDirectChildrenOnly);
   auto it = groupBoxes.begin();
 
-  for (const std::unique_ptr<Option>& option : object.get_options())
+  for (const Option& option : scratch->get_options())
   {
     QGroupBox* groupBox = *it++;
-    option->set_form_value(groupBox);
+    set_option_form_value(option, groupBox);
   }
 }
 
@@ -122,10 +344,10 @@ bool Dialog::set_object_options()
   QList<QGroupBox*> groupBoxes = parent->findChildren<QGroupBox*>(QString(), Qt::FindDirectChildrenOnly);
   auto it = groupBoxes.begin();
 
-  for (std::unique_ptr<Option>& option : object.get_options())
+  for (Option& option : scratch->get_options())
   {
     QGroupBox* groupBox = *it++;
-    bool valid = option->set_option(groupBox);
+    bool valid = set_option_from_form(option, groupBox);
 
     if (!valid)
     {
@@ -137,3 +359,40 @@ bool Dialog::set_object_options()
 
   return true;
 }
+
+QGroupBox* Dialog::check_options()
+{
+  std::vector<ConstraintViolation> violations;
+  check_constraints(*scratch, violations);
+
+  std::vector<QString> messages(groupBoxes.size());
+
+  for (const ConstraintViolation& violation : violations)
+  {
+    // the nested options are checked by their own dialog
+    if (violation.object != scratch.get())
+    {
+      continue;
+    }
+
+    messages[violation.option] += "\n" + QString::fromStdString(violation.message);
+  }
+
+  QGroupBox* first = nullptr;
+
+  for (std::size_t i = 0; i < groupBoxes.size(); i++)
+  {
+    QGroupBox* groupBox = groupBoxes[i];
+    const QString description = QString::fromStdString(scratch->get_options()[i].get_description());
+
+    groupBox->setStyleSheet(messages[i].isEmpty() ? QString() : "QGroupBox { color: red; }");
+    groupBox->setToolTip(description + messages[i]);
+
+    if (!first && !messages[i].isEmpty())
+    {
+      first = groupBox;
+    }
+  }
+
+  return first;
+}
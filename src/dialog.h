@@ -23,9 +23,13 @@
 
 #include <QDialog>
 
+#include <memory>
+#include <vector>
+
 namespace Ui {
   class Dialog;
 }
+class QGroupBox;
 class Object;
 
 /*
@@ -39,6 +43,12 @@ class Dialog : public QDialog
 
   Object& object;
 
+  // detached copy of @object edited by the form, the configuration is changed only on accept
+  std::unique_ptr<Object> scratch;
+
+  // one for each option of @object, in the same order
+  std::vector<QGroupBox*> groupBoxes;
+
 public:
   explicit Dialog(Object& object,
                   QWidget* parent = 0);
@@ -47,7 +57,6 @@ public:
 public slots:
   int exec();
   void accept();
-  void reject();
 
 private:
   /*
@@ -57,17 +66,25 @@ private:
   void create_form();
 
   /*
-   * Display the current value of the Object's options.
+   * Display the current value of the options of @scratch.
    * Called at dialog exec and when RestoreDefaults is pressed.
    */
   void set_form_values();
 
   /*
+   * Sets the options of @scratch from the form.
    * @return: true if all required options are set, false otherwise.
    * Called when OK is pressed.
    */
   bool set_object_options();
 
+  /*
+   * Checks the constraints of the options of @scratch, the group boxes of the violated ones are marked.
+   * Called whenever an option is edited, the check is cheap enough for every keystroke.
+   * @return: the group box of the first violated option, nullptr if there are no violations.
+   */
+  QGroupBox* check_options();
+
   // non copyable
   Dialog(const Dialog&) = delete;
   Dialog& operator=(const Dialog&) = delete;
@@ -32,8 +32,94 @@
 #include <QBoxLayout>
 #include <QIcon>
 
+#include <cmath>
+#include <map>
+
 #define ICON_SIZE 80
 
+namespace
+{
+  // the shape of each Object type, the model itself knows nothing about drawing
+
+  // circle shape
+  void draw_source(QPainter* painter, int width, int height)
+  {
+    painter->setBrush(QColor(255, 128, 128, 192));
+    painter->drawEllipse(1, 1, width - 2, height - 2);
+  }
+
+  // rectangle shape
+  void draw_destination(QPainter* painter, int width, int height)
+  {
+    painter->setBrush(QColor(128, 128, 225, 192));
+    painter->drawRect(1, 1, width - 2, height - 2);
+  }
+
+  // rhombus shape
+  void draw_filter(QPainter* painter, int width, int height)
+  {
+    QPainterPath path;
+    path.moveTo(width/2.0, 1);
+    path.lineTo(width - 1, height/2.0);
+    path.lineTo(width/2.0, height - 1);
+    path.lineTo(1, height/2.0);
+    path.closeSubpath();
+
+    painter->setBrush(QColor(128, 255, 128, 192));
+    painter->drawPath(path);
+    painter->fillPath(path, painter->brush());
+  }
+
+  // circle shape, no fill
+  void draw_template(QPainter* painter, int width, int height)
+  {
+    painter->setPen(QColor(255, 128, 255, 192));
+    painter->drawEllipse(1, 1, width - 2, height - 2);
+  }
+
+  // hexagon shape
+  void draw_rewrite(QPainter* painter, int width, int height)
+  {
+    const double pi = std::acos(-1);
+    double h = (1 - std::cos(pi/6.0))*(height - 2)/2;
+
+    QPainterPath path;
+    path.moveTo(width/2.0, 1);
+    path.lineTo(width - 1 - h, 1 + (height - 2)*1/4.0);
+    path.lineTo(width - 1 - h, 1 + (height - 2)*3/4.0);
+    path.lineTo(width/2.0, height - 1);
+    path.lineTo(1 + h, 1 + (height - 2)*3/4.0);
+    path.lineTo(1 + h, 1 + (height - 2)*1/4.0);
+    path.closeSubpath();
+
+    painter->setBrush(QColor(128, 255, 255, 192));
+    painter->drawPath(path);
+    painter->fillPath(path, painter->brush());
+  }
+
+  // Google-themed shape, a tribute to GSoC
+  void draw_parser(QPainter* painter, int width, int height)
+  {
+    painter->setBrush(QColor(255, 16, 32));
+    painter->drawEllipse(1 + width*1/4.0, 1, (width - 2)/2.0, (height - 2)/2.0);
+    painter->setBrush(QColor(0, 128, 32));
+    painter->drawEllipse(1 + width*1/4.0, height/2.0, (width - 2)/2.0, (height - 2)/2.0);
+    painter->setBrush(QColor(64, 128, 255));
+    painter->drawEllipse(1, 1 + (height - 2)*1/4.0, (width - 2)/2.0, (height - 2)/2.0);
+    painter->setBrush(QColor(255, 192, 16));
+    painter->drawEllipse(width/2.0, 1 + (height - 2)*1/4.0, (width - 2)/2.0, (height - 2)/2.0);
+  }
+
+  const std::map<std::string, void(*)(QPainter*, int, int)> draw_object_map {
+    {"source", draw_source},
+    {"destination", draw_destination},
+    {"filter", draw_filter},
+    {"template", draw_template},
+    {"rewrite", draw_rewrite},
+    {"parser", draw_parser}
+  };
+}
+
 Icon::Icon(QWidget* parent) :
   QWidget(parent)
 {}
@@ -93,7 +179,12 @@ ObjectIcon::ObjectIcon(std::shared_ptr<Object>& object,
   painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
   painter.setPen(Qt::black);
 
-  get_object()->draw(&painter, width(), height());
+  // Options have no shape
+  auto draw = draw_object_map.find(get_object()->get_type());
+  if (draw != draw_object_map.end())
+  {
+    draw->second(&painter, width(), height());
+  }
 
   painter.end();
 
@@ -131,6 +222,11 @@ FilterIcon::FilterIcon(std::shared_ptr<Object>& object,
   comboBox->addItem("and");
   comboBox->addItem("or");
 
+  // the filter can come from an opened project
+  const Filter& filter = static_cast<const Filter&>(*get_object());
+  checkBox->setChecked(filter.get_invert());
+  comboBox->setCurrentText(QString::fromStdString(filter.get_next()));
+
   QVBoxLayout* mainLayout = static_cast<QVBoxLayout*>(layout());
   mainLayout->insertWidget(0, checkBox);
   mainLayout->addWidget(comboBox);
@@ -176,6 +272,11 @@ void StatementIcon::add_icon(Icon* icon)
 }
 
 void StatementIcon::remove_icon(Icon* icon)
+{
+  detach_icon(icon);
+}
+
+void StatementIcon::detach_icon(Icon* icon)
 {
   QBoxLayout* frameLayout = findChild<QBoxLayout*>("frameLayout");
   frameLayout->removeWidget(icon);
@@ -185,6 +286,20 @@ void StatementIcon::remove_icon(Icon* icon)
   adjustSize();
 }
 
+void StatementIcon::move_icon(Icon* icon)
+{
+  StatementIcon::add_icon(icon);
+}
+
+void StatementIcon::attach_icon(Icon* icon)
+{
+  QBoxLayout* frameLayout = findChild<QBoxLayout*>("frameLayout");
+  frameLayout->addWidget(icon);
+
+  icon->show();
+  adjustSize();
+}
+
 int StatementIcon::get_index(Icon* icon)
 {
   QBoxLayout* frameLayout = findChild<QBoxLayout*>("frameLayout");
@@ -242,16 +357,35 @@ void ObjectStatementIcon::add_icon(Icon* icon)
 
 void ObjectStatementIcon::remove_icon(Icon* icon)
 {
-  StatementIcon::remove_icon(icon);
+  detach_icon(icon);
+
+  ObjectIcon* object_icon = static_cast<ObjectIcon*>(icon);
+  std::shared_ptr<Object>& object = object_icon->get_object();
+
+  object_statement->remove_object(object);
+}
+
+void ObjectStatementIcon::detach_icon(Icon* icon)
+{
+  StatementIcon::detach_icon(icon);
 
   // if the Icon is inside a LogStatementIcon
   parent()->parent()->findChild<QBoxLayout*>("frameLayout")->activate();
   parentWidget()->parentWidget()->adjustSize();
+}
+
+void ObjectStatementIcon::move_icon(Icon* icon)
+{
+  StatementIcon::move_icon(icon);
+
+  // if the Icon is inside a LogStatementIcon
+  parentWidget()->parentWidget()->adjustSize();
 
   ObjectIcon* object_icon = static_cast<ObjectIcon*>(icon);
   std::shared_ptr<Object>& object = object_icon->get_object();
+  int index = findChild<QBoxLayout*>("frameLayout")->indexOf(icon);
 
-  object_statement->remove_object(object);
+  object_statement->move_object(object, index);
 }
 
 
@@ -285,12 +419,23 @@ LogStatementIcon::LogStatementIcon(std::shared_ptr<LogStatement>& log_statement,
   findChild<QBoxLayout*>("mainLayout")->setDirection(QBoxLayout::LeftToRight);
 }
 
-void LogStatementIcon::add_icon(Icon* icon)
+std::shared_ptr<LogStatement>& LogStatementIcon::get_log_statement()
 {
-  StatementIcon::add_icon(icon);
+  return log_statement;
+}
 
+void LogStatementIcon::add_icon(Icon* icon)
+{
+  // each ObjectStatement only once, e.g. not both the original and a copy
   ObjectStatementIcon* statement_icon = static_cast<ObjectStatementIcon*>(icon);
   std::shared_ptr<ObjectStatement>& object_statement = statement_icon->get_object_statement();
+  if (log_statement->get_object_statements().contains(object_statement))
+  {
+    return;
+  }
+
+  StatementIcon::add_icon(icon);
+
   int index = findChild<QBoxLayout*>("frameLayout")->indexOf(icon);
 
   log_statement->add_object_statement(object_statement, index);
@@ -298,15 +443,31 @@ void LogStatementIcon::add_icon(Icon* icon)
 
 void LogStatementIcon::remove_icon(Icon* icon)
 {
-  StatementIcon::remove_icon(icon);
+  detach_icon(icon);
+
+  ObjectStatementIcon* statement_icon = static_cast<ObjectStatementIcon*>(icon);
+  std::shared_ptr<ObjectStatement>& object_statement = statement_icon->get_object_statement();
+
+  log_statement->remove_object_statement(object_statement);
+}
+
+void LogStatementIcon::detach_icon(Icon* icon)
+{
+  StatementIcon::detach_icon(icon);
 
   // each ObjectStatementIcon has the same size inside the LogStatementIcon, so after it's removed it can return to its original size
   icon->adjustSize();
+}
+
+void LogStatementIcon::move_icon(Icon* icon)
+{
+  StatementIcon::move_icon(icon);
 
   ObjectStatementIcon* statement_icon = static_cast<ObjectStatementIcon*>(icon);
   std::shared_ptr<ObjectStatement>& object_statement = statement_icon->get_object_statement();
+  int index = findChild<QBoxLayout*>("frameLayout")->indexOf(icon);
 
-  log_statement->remove_object_statement(object_statement);
+  log_statement->move_object_statement(object_statement, index);
 }
 
 void LogStatementIcon::mouseDoubleClickEvent(QMouseEvent *)
@@ -112,6 +112,22 @@ public:
   virtual void add_icon(Icon* icon);
   virtual void remove_icon(Icon* icon);
 
+  /*
+   * Take @icon out of the layout only, its element stays in the statement while it's dragged.
+   * Followed by move_icon() if it's dropped back, remove_icon() otherwise.
+   */
+  virtual void detach_icon(Icon* icon);
+
+  /*
+   * Put the detached @icon back at its new place, and move its element there too.
+   */
+  virtual void move_icon(Icon* icon);
+
+  /*
+   * Put @icon at the end, its element is already in the statement, e.g. when a project is opened.
+   */
+  void attach_icon(Icon* icon);
+
 private:
   /*
    * Calculate where to insert the new icon based on its position relative to the others.
@@ -137,6 +153,8 @@ public:
 
   void add_icon(Icon* icon);
   void remove_icon(Icon* icon);
+  void detach_icon(Icon* icon);
+  void move_icon(Icon* icon);
 
 protected:
   void mouseDoubleClickEvent(QMouseEvent *) {}
@@ -168,8 +186,12 @@ public:
   explicit LogStatementIcon(std::shared_ptr<LogStatement>& log_statement,
                             QWidget* parent = 0);
 
+  std::shared_ptr<LogStatement>& get_log_statement();
+
   void add_icon(Icon* icon);
   void remove_icon(Icon* icon);
+  void detach_icon(Icon* icon);
+  void move_icon(Icon* icon);
 
 protected:
   void mouseDoubleClickEvent(QMouseEvent *);
@@ -22,38 +22,56 @@
 #include "ui_mainwindow.h"
 #include "scene.h"
 #include "dialog.h"
+#include "sink.h"
+#include "project.h"
+#include "linter.h"
 
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QInputDialog>
-#include <QTextStream>
 #include <QCloseEvent>
-#include <QProcess>
+#include <QTimer>
+#include <QLabel>
 
 MainWindow::MainWindow(QWidget* parent) :
   QMainWindow(parent),
   ui(new Ui::MainWindow),
-  scene(new Scene(config))
+  scene(new Scene(config)),
+  lintLabel(new QLabel(this))
 {
   ui->setupUi(this);
+  ui->statusBar->addPermanentWidget(lintLabel);
 
   ui->actionNew->setShortcut(QKeySequence::New);
+  ui->actionOpenProject->setShortcut(QKeySequence::Open);
   ui->actionSave->setShortcut(QKeySequence::Save);
   ui->actionQuit->setShortcut(QKeySequence::Quit);
 
-  ui->sourceWidget->setupObjects("source", config.get_default_objects());
-  ui->destinationWidget->setupObjects("destination", config.get_default_objects());
-  ui->filterWidget->setupObjects("filter", config.get_default_objects());
-  ui->templateWidget->setupObjects("template", config.get_default_objects());
-  ui->rewriteWidget->setupObjects("rewrite", config.get_default_objects());
-  ui->parserWidget->setupObjects("parser", config.get_default_objects());
+  ui->sourceWidget->setupObjects(config.get_default_objects("source"));
+  ui->destinationWidget->setupObjects(config.get_default_objects("destination"));
+  ui->filterWidget->setupObjects(config.get_default_objects("filter"));
+  ui->templateWidget->setupObjects(config.get_default_objects("template"));
+  ui->rewriteWidget->setupObjects(config.get_default_objects("rewrite"));
+  ui->parserWidget->setupObjects(config.get_default_objects("parser"));
 
   ui->sceneScrollArea->setWidget(scene);
 
   setupConnections();
 
   ui->actionLogStatement->trigger();  // the Scene widget has a LogStatement by default
-  last_saved_config = QString::fromStdString(config.to_string());  // empty config contains version information
+  saved_generation = config.get_generation();
+
+  // the syntax is checked in the background whenever the configuration changes, the linter is fast enough to run here
+  QTimer* timer = new QTimer(this);
+  connect(timer, &QTimer::timeout, [this]() {
+    if (validated_generation != config.get_generation())
+    {
+      validated_generation = config.get_generation();
+      validator.validate(config);
+      lint_config();
+    }
+  });
+  timer->start(250);
 }
 
 MainWindow::~MainWindow()
@@ -64,7 +82,7 @@ MainWindow::~MainWindow()
 void MainWindow::closeEvent(QCloseEvent* event)
 {
   // Check if the configuration has changed since the last save
-  if (last_saved_config == QString::fromStdString(config.to_string()))
+  if (saved_generation == config.get_generation())
   {
     event->accept();
   }
@@ -82,15 +100,29 @@ void MainWindow::closeEvent(QCloseEvent* event)
   }
 }
 
+void MainWindow::lint_config()
+{
+  const std::vector<LintDiagnostic> diagnostics = lint(config);
+
+  QString warnings;
+  for (const LintDiagnostic& diagnostic : diagnostics)
+  {
+    warnings += QString::fromStdString(diagnostic.location + ": " + diagnostic.message) + "\n";
+  }
+
+  lintLabel->setText(diagnostics.empty() ? QString() : QString("%1 warnings").arg(diagnostics.size()));
+  lintLabel->setToolTip(warnings.trimmed());
+}
+
 void MainWindow::setupConnections()
 {
   connect(ui->actionNew, &QAction::triggered, [&]() {
     if (QMessageBox::question(this, "New configuration",
       "Current configuration will be lost! Are you sure?") == QMessageBox::Yes)
     {
-      for (std::unique_ptr<Option>& option : config.get_global_options().get_options())
+      for (Option& option : config.get_global_options().get_options())
       {
-        option->restore_default();
+        option.restore_default();
       }
 
       scene->reset();
@@ -108,41 +140,164 @@ void MainWindow::setupConnections()
     QFile file(file_name);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
     {
+      QMessageBox::warning(this, "Save", file.errorString());
       return;
     }
 
-    last_saved_config = QString::fromStdString(config.to_string());
-
-    QTextStream out(&file);
-    out << last_saved_config;
+    // written piece by piece, there is no string of the whole configuration
+    bool failed = false;
+    {
+      DeviceSink sink(&file);
+      config.write(sink);
+      sink.flush();
+      failed = sink.has_failed();
+    }
 
     file.close();
 
-    // check config file syntax with the "syslog-ng -s -f FILE" command
-    QProcess* process = new QProcess(this);
-    process->start("syslog-ng", { "-s", "-f", file_name });
+    if (failed)
+    {
+      QMessageBox::warning(this, "Save", file.errorString());
+      return;
+    }
+
+    saved_generation = config.get_generation();
+
+    // check config file syntax with the "syslog-ng -s -f FILE" command, the errors are shown in a message box
+    report_validation = true;
+    validator.validate_now(config);
+  });
 
-    connect(process, static_cast<void(QProcess::*)(int)>(&QProcess::finished), [this, process](int ) {
-      QByteArray array = process->readAllStandardError();
-      if (!array.isEmpty())
+  connect(ui->actionOpenProject, &QAction::triggered, [&]() {
+    if (saved_generation != config.get_generation() &&
+      QMessageBox::question(this, "Open project",
+      "Current configuration will be lost! Are you sure?") != QMessageBox::Yes)
+    {
+      return;
+    }
+
+    QString file_name = QFileDialog::getOpenFileName(this, tr("Open project"), QDir::homePath(), tr("Projects (*.sngproj)"));
+    if (file_name.isEmpty())
+    {
+      return;
+    }
+
+    ProjectReader reader(config);
+
+    // the global options are applied only if the whole project could be opened
+    Options global_options(config.get_global_options());
+    try
+    {
+      reader.open(file_name.toStdString());
+
+      for (Option& option : global_options.get_options())
       {
-        QMessageBox::warning(this, "Configuration file syntax", QString(array));
+        option.restore_default();
       }
-    });
+
+      reader.load_global_options(global_options);
+      reader.load_statements();
+      scene->open_project(reader);
+    }
+    catch (const std::runtime_error& error)
+    {
+      QMessageBox::warning(this, "Open project", QString::fromStdString(error.what()));
+      return;
+    }
+
+    OptionVector& options = config.get_global_options().get_options();
+    for (std::size_t i = 0; i < options.size(); i++)
+    {
+      options[i].set_values(global_options.get_options()[i]);
+    }
+
+    saved_generation = config.get_generation();
+
+    // the schemas changed since the project was saved
+    if (!reader.get_warnings().empty())
+    {
+      QString warnings;
+      for (const std::string& warning : reader.get_warnings())
+      {
+        warnings += QString::fromStdString(warning) + "\n";
+      }
+
+      QMessageBox::warning(this, "Open project", "Skipped:\n" + warnings);
+    }
+  });
+
+  connect(ui->actionSaveProject, &QAction::triggered, [&]() {
+    QString file_name = QFileDialog::getSaveFileName(this, tr("Save project"), QDir::homePath(), tr("Projects (*.sngproj)"));
+    if (file_name.isEmpty())
+    {
+      return;
+    }
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+      QMessageBox::warning(this, "Save project", file.errorString());
+      return;
+    }
+
+    ProjectWriter writer(config);
+    scene->save_project(writer);
+
+    bool failed = false;
+    {
+      DeviceSink sink(&file);
+      writer.write(sink);
+      sink.flush();
+      failed = sink.has_failed();
+    }
+
+    file.close();
+
+    if (failed)
+    {
+      QMessageBox::warning(this, "Save project", file.errorString());
+      return;
+    }
+
+    saved_generation = config.get_generation();
   });
 
   connect(ui->actionQuit, &QAction::triggered, this, &MainWindow::close);
 
+  connect(&validator, &Validator::validated, [this](const ValidationResult& result) {
+    const QString time = QString(result.cached ? " (%1 ms, cached)" : " (%1 ms)").arg(result.milliseconds);
+
+    switch (result.status)
+    {
+      case ValidationStatus::VALID:
+        ui->statusBar->showMessage("Configuration is valid" + time);
+        break;
+      case ValidationStatus::INVALID:
+        ui->statusBar->showMessage("Configuration has syntax errors" + time);
+        if (report_validation)
+        {
+          QMessageBox::warning(this, "Configuration file syntax", QString::fromStdString(result.message));
+        }
+        break;
+      case ValidationStatus::TIMED_OUT:
+        ui->statusBar->showMessage("Syntax check timed out" + time);
+        break;
+      case ValidationStatus::NOT_STARTED:
+      case ValidationStatus::CANCELED:
+        ui->statusBar->showMessage(QString::fromStdString(result.message));
+        break;
+    }
+
+    report_validation = false;
+  });
+
 
   connect(ui->actionOptions, &QAction::triggered, [&]() {
     Dialog(config.get_global_options(), this).exec();
   });
 
   connect(ui->actionLogStatement, &QAction::triggered, [&]() {
-    const Options& log_options = static_cast<const Options&>(config.get_default_object("log", "options"));
-    LogStatement* new_log_statement = new LogStatement(log_options);
-
-    std::shared_ptr<LogStatement> log_statement = config.add_log_statement(new_log_statement);
+    std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
     scene->add_log_statement(log_statement, QPoint(200, 30));
   });
 
@@ -161,18 +316,16 @@ void MainWindow::setupConnections()
     }
 
     std::string id = text.toStdString();
-    for (const std::unique_ptr<ObjectStatement>& statement : config.get_object_statements())
+    for (const ObjectStatement& statement : config.get_object_statements())
     {
-      if (statement->get_id() == id)
+      if (statement.get_id() == id)
       {
         QMessageBox::warning(this, "Warning", "ID already in use!");
         return;
       }
     }
 
-    ObjectStatement* new_object_statement = new ObjectStatement(id);
-
-    std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(new_object_statement);
+    std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(id);
     scene->add_object_statement(object_statement, QPoint(50, 150));
   });
 
@@ -22,6 +22,7 @@
 #define MAINWINDOW_H
 
 #include "config.h"
+#include "validator.h"
 
 #include <QMainWindow>
 
@@ -29,6 +30,7 @@ namespace Ui {
   class MainWindow;
 }
 class Scene;
+class QLabel;
 
 class MainWindow : public QMainWindow
 {
@@ -37,8 +39,14 @@ class MainWindow : public QMainWindow
   Ui::MainWindow* ui;
   Scene* scene;
 
+  // the number of lint warnings in the status bar, the warnings are in its tooltip
+  QLabel* lintLabel;
+
   Config config;
 
+  // declared after the config, which it validates
+  Validator validator;
+
 public:
   explicit MainWindow(QWidget* parent = 0);
   ~MainWindow();
@@ -49,12 +57,21 @@ protected:
 private:
   void setupConnections();
 
+  // runs the linter and shows the warnings in lintLabel
+  void lint_config();
+
   // non copyable
   MainWindow(const MainWindow&) = delete;
   MainWindow& operator=(const MainWindow&) = delete;
 
   // used at application exit to warn the user if there are changes to the last saved config
-  QString last_saved_config;
+  std::uint64_t saved_generation = 0;
+
+  // the configuration is validated again when it changes
+  std::uint64_t validated_generation = 0;
+
+  // the errors of a check requested by saving are shown in a message box, not only in the status bar
+  bool report_validation = false;
 };
 
 #endif // MAINWINDOW_H
@@ -22,6 +22,7 @@
 #include "config.h"
 #include "icon.h"
 #include "dialog.h"
+#include "project.h"
 
 #include <QLabel>
 #include <QDropEvent>
@@ -90,14 +91,157 @@ void Scene::add_icon(Icon* icon, const QPoint& pos)
 
 void Scene::reset()
 {
+  dragged_from = nullptr;
+
+  // deleted right away, so their statements and Objects are destroyed before the memory is released
   for (Icon* icon : findChildren<Icon*>(QString(), Qt::FindDirectChildrenOnly))
   {
-    icon->deleteLater();
+    delete icon;
   }
 
+  config.release_memory();
+
   updateGeometry();
 }
 
+void Scene::save_project(ProjectWriter& writer) const
+{
+  for (Icon* icon : findChildren<Icon*>(QString(), Qt::FindDirectChildrenOnly))
+  {
+    const QPoint pos = icon->pos() + QPoint(icon->width()/2, icon->height()/2);
+
+    if (LogStatementIcon* log_statement_icon = dynamic_cast<LogStatementIcon*>(icon))
+    {
+      writer.add_log_statement_icon(*log_statement_icon->get_log_statement(), pos.x(), pos.y());
+    }
+    else if (ObjectStatementIcon* object_statement_icon = dynamic_cast<ObjectStatementIcon*>(icon))
+    {
+      const bool copy = dynamic_cast<ObjectStatementIconCopy*>(icon) != nullptr;
+      writer.add_object_statement_icon(*object_statement_icon->get_object_statement(), copy, pos.x(), pos.y());
+    }
+    else if (ObjectIcon* object_icon = dynamic_cast<ObjectIcon*>(icon))
+    {
+      writer.add_object_icon(*object_icon->get_object(), pos.x(), pos.y());
+    }
+  }
+}
+
+/*
+ * The first icon of an ObjectStatement is the original, the others are copies.
+ * Statements inside log statements are not saved as icons, the original goes to the first log statement,
+ * unless it's on the canvas on its own.
+ */
+void Scene::open_project(ProjectReader& reader)
+{
+  reset();
+
+  std::unordered_set<const ObjectStatement*> opened;
+  for (std::size_t i = 0; i < reader.get_icon_count(); i++)
+  {
+    const ProjectIcon icon = reader.get_icon(i);
+    if (icon.kind == ProjectIcon::OBJECT_STATEMENT)
+    {
+      opened.insert(reader.get_object_statement(icon.index).get());
+    }
+  }
+
+  std::unordered_set<const LogStatement*> opened_logs;
+  for (std::size_t i = 0; i < reader.get_icon_count(); i++)
+  {
+    const ProjectIcon icon = reader.get_icon(i);
+    const QPoint pos(icon.x, icon.y);
+
+    switch (icon.kind)
+    {
+      case ProjectIcon::OBJECT:
+      {
+        std::shared_ptr<Object> object = reader.get_object(icon.index);
+        if (object)
+        {
+          add_object(object, pos);
+        }
+        break;
+      }
+      case ProjectIcon::OBJECT_STATEMENT:
+        open_object_statement(reader.get_object_statement(icon.index), pos);
+        break;
+      case ProjectIcon::OBJECT_STATEMENT_COPY:
+      {
+        std::shared_ptr<ObjectStatement> object_statement = reader.get_object_statement(icon.index);
+        add_object_statement_copy(object_statement, pos)->releaseMouse();
+        break;
+      }
+      case ProjectIcon::LOG_STATEMENT:
+      {
+        std::shared_ptr<LogStatement> log_statement = reader.get_log_statement(icon.index);
+        opened_logs.insert(log_statement.get());
+        open_log_statement(log_statement, pos, opened);
+        break;
+      }
+    }
+  }
+
+  // saved without icons, e.g. by the command line tools
+  for (std::size_t i = 0; i < reader.get_log_statement_count(); i++)
+  {
+    std::shared_ptr<LogStatement> log_statement = reader.get_log_statement(i);
+    if (opened_logs.insert(log_statement.get()).second)
+    {
+      open_log_statement(log_statement, QPoint(200, 30), opened);
+    }
+  }
+
+  for (std::size_t i = 0; i < reader.get_object_statement_count(); i++)
+  {
+    std::shared_ptr<ObjectStatement> object_statement = reader.get_object_statement(i);
+    if (opened.insert(object_statement.get()).second)
+    {
+      open_object_statement(object_statement, QPoint(50, 150));
+    }
+  }
+}
+
+ObjectStatementIcon* Scene::open_object_statement(std::shared_ptr<ObjectStatement> object_statement, const QPoint& pos)
+{
+  ObjectStatementIcon* icon = add_object_statement(object_statement, pos);
+
+  for (const std::shared_ptr<const Object>& element : icon->get_object_statement()->get_objects())
+  {
+    std::shared_ptr<Object> object = std::const_pointer_cast<Object>(element);
+    icon->attach_icon(add_object(object, QPoint()));
+  }
+
+  icon->move(pos - QPoint(icon->width()/2, icon->height()/2));
+  return icon;
+}
+
+LogStatementIcon* Scene::open_log_statement(std::shared_ptr<LogStatement> log_statement, const QPoint& pos,
+                                            std::unordered_set<const ObjectStatement*>& opened)
+{
+  LogStatementIcon* icon = add_log_statement(log_statement, pos);
+
+  for (const std::shared_ptr<const ObjectStatement>& element : icon->get_log_statement()->get_object_statements())
+  {
+    std::shared_ptr<ObjectStatement> object_statement = std::const_pointer_cast<ObjectStatement>(element);
+
+    ObjectStatementIcon* object_statement_icon = nullptr;
+    if (opened.insert(element.get()).second)
+    {
+      object_statement_icon = open_object_statement(object_statement, QPoint());
+    }
+    else
+    {
+      object_statement_icon = add_object_statement_copy(object_statement, QPoint());
+      object_statement_icon->releaseMouse();
+    }
+
+    icon->attach_icon(object_statement_icon);
+  }
+
+  icon->move(pos - QPoint(icon->width()/2, icon->height()/2));
+  return icon;
+}
+
 /*
  * Responsible for making ObjectStatementIcon copies and removing icons from their parent StatementIcons.
  */
@@ -125,7 +269,8 @@ void Scene::pressed(Icon* icon)
   {
     QPoint pos = icon->parentWidget()->mapTo(this, icon->pos());
     StatementIcon* statement_icon = static_cast<StatementIcon*>(icon->parent()->parent());
-    statement_icon->remove_icon(icon);
+    statement_icon->detach_icon(icon);
+    dragged_from = statement_icon;
     icon->setParent(this);
     icon->move(pos);
     icon->show();
@@ -143,6 +288,9 @@ void Scene::released(Icon* icon)
   DeleteIcon* deleteIcon = findChild<DeleteIcon*>();
   deleteIcon->hide();
 
+  StatementIcon* origin = dragged_from;
+  dragged_from = nullptr;
+
   // if icons inside StatementIcons break loose (hopefully never), this prevents them from getting deleted
   if (icon->parent() != this)
   {
@@ -152,6 +300,11 @@ void Scene::released(Icon* icon)
   // delete icons
   if (icon->geometry().intersects(deleteIcon->geometry()))
   {
+    if (origin)
+    {
+      origin->remove_icon(icon);
+    }
+
     ObjectStatementIcon* statement_icon = dynamic_cast<ObjectStatementIcon*>(icon);
     if (statement_icon && !dynamic_cast<ObjectStatementIconCopy*>(icon))
     {
@@ -177,6 +330,18 @@ void Scene::released(Icon* icon)
     statement_icon = select_nearest_log_statement_icon(pos);
   }
 
+  // dropped back to where it was taken from, only its position changes
+  if (statement_icon && statement_icon == origin)
+  {
+    statement_icon->move_icon(icon);
+    return;
+  }
+
+  if (origin)
+  {
+    origin->remove_icon(icon);
+  }
+
   if (statement_icon)
   {
     statement_icon->add_icon(icon);
@@ -229,13 +394,11 @@ void Scene::dropEvent(QDropEvent* event)
   QString name, type;
   dataStream >> name >> type;
 
-  const Object& default_object = config.get_default_object(name.toStdString(), type.toStdString());
-  Object* new_object = default_object.clone();
+  std::shared_ptr<Object> new_object = config.create_object(name.toStdString(), type.toStdString());
 
   if (Dialog(*new_object, this).exec() == QDialog::Accepted)
   {
-    std::shared_ptr<Object> object(new_object);
-    add_object(object, event->pos());
+    add_object(new_object, event->pos());
   }
 }
 
@@ -24,16 +24,20 @@
 #include <QWidget>
 
 #include <memory>
+#include <unordered_set>
 
 class Config;
 class Object;
 class ObjectStatement;
 class LogStatement;
 class Icon;
+class StatementIcon;
 class ObjectIcon;
 class ObjectStatementIcon;
 class ObjectStatementIconCopy;
 class LogStatementIcon;
+class ProjectWriter;
+class ProjectReader;
 
 /*
  * Widget for displaying all the icons that make up the config.
@@ -44,6 +48,9 @@ class Scene : public QWidget
 
   Config& config;
 
+  // the StatementIcon the dragged icon was taken from, if any
+  StatementIcon* dragged_from = nullptr;
+
 public:
   explicit Scene(Config& config,
                  QWidget* parent = 0);
@@ -58,6 +65,16 @@ public:
    */
   void reset();
 
+  /*
+   * Adds the icons on the canvas to @writer, with their positions.
+   */
+  void save_project(ProjectWriter& writer) const;
+
+  /*
+   * Replaces the icons with the ones of the project, its configuration is already loaded by @reader.
+   */
+  void open_project(ProjectReader& reader);
+
 protected:
   void leaveEvent(QEvent *);
 
@@ -82,6 +99,14 @@ private:
    */
   void add_icon(Icon* icon, const QPoint& pos);
 
+  /*
+   * Creates the icon of an opened statement and the icons of its elements, centered at @pos.
+   * @opened: the ObjectStatements which have an original icon already, the others get one, and are added to it.
+   */
+  ObjectStatementIcon* open_object_statement(std::shared_ptr<ObjectStatement> object_statement, const QPoint& pos);
+  LogStatementIcon* open_log_statement(std::shared_ptr<LogStatement> log_statement, const QPoint& pos,
+                                       std::unordered_set<const ObjectStatement*>& opened);
+
   /*
    * When deleting an ObjectStatementIcon, make sure that all it's copies are also deleted.
    */
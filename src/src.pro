@@ -1,16 +1,13 @@
 TEMPLATE = app
-CONFIG += c++14
+CONFIG += c++17
 TARGET = syslog-ng-config-qt
 DESTDIR = ../
 MOC_DIR = ../build/moc
 OBJECTS_DIR = ../build/obj
 QT += core gui widgets
-LIBS += -lyaml-cpp
+include(../core/core.pri)
 
 SOURCES += \
-    option.cpp \
-    object.cpp \
-    config.cpp \
     icon.cpp \
     tab.cpp \
     dialog.cpp \
@@ -19,9 +16,6 @@ SOURCES += \
     main.cpp
 
 HEADERS += \
-    option.h \
-    object.h \
-    config.h \
     icon.h \
     tab.h \
     dialog.h \
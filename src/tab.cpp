@@ -19,7 +19,7 @@
  */
 
 #include "tab.h"
-#include "object.h"
+#include "config.h"
 #include "icon.h"
 
 #include <QGridLayout>
@@ -32,27 +32,24 @@ Tab::Tab(QWidget* parent) :
   QWidget(parent)
 {}
 
-void Tab::setupObjects(const std::string& object_type, const std::vector< std::unique_ptr<const Object> >& default_objects)
+void Tab::setupObjects(const DefaultObjectRange& default_objects)
 {
   QGridLayout* mainLayout = static_cast<QGridLayout*>(layout());
   mainLayout->setSpacing(10);
 
   int row = 0, col = 0;
-  for (const std::unique_ptr<const Object>& default_object : default_objects)
+  for (const Object* default_object : default_objects)
   {
-    if (default_object->get_type() == object_type)
-    {
-      std::shared_ptr<Object> object(default_object->clone());
-      DefaultObjectIcon* icon = new DefaultObjectIcon(object, this);
-      mainLayout->addWidget(icon, row, col++);
+    std::shared_ptr<Object> object(default_object->clone());
+    DefaultObjectIcon* icon = new DefaultObjectIcon(object, this);
+    mainLayout->addWidget(icon, row, col++);
 
-      connect(icon, &Icon::pressed, this, &Tab::drag);
+    connect(icon, &Icon::pressed, this, &Tab::drag);
 
-      if (col == N_GRID_COLUMN)
-      {
-        col = 0;
-        row++;
-      }
+    if (col == N_GRID_COLUMN)
+    {
+      col = 0;
+      row++;
     }
   }
 }
@@ -25,7 +25,7 @@
 
 #include <memory>
 
-class Object;
+class DefaultObjectRange;
 class Icon;
 
 /*
@@ -42,7 +42,7 @@ public:
   /*
    * Create and insert DefaultObjectIcons into the widget's grid layout.
    */
-  void setupObjects(const std::string& object_type, const std::vector< std::unique_ptr<const Object> >& default_objects);
+  void setupObjects(const DefaultObjectRange& default_objects);
 
 private:
   void drag(Icon* icon);
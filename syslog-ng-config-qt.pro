@@ -1,5 +1,7 @@
 TEMPLATE = subdirs
-SUBDIRS += src tests
-
-tests.depends = src
+SUBDIRS += schemagen core src cli tests
 
+core.depends = schemagen
+src.depends = core
+cli.depends = core
+tests.depends = core
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "builtin.h"
+#include "schema.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QtTest/QTest>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*
+ * Every compiled in table has to describe the same schema as its yaml file,
+ * schemagen writes them in the order of the sorted file names.
+ */
+void Test::tables_test_data()
+{
+  const QDir dir("../../objects");
+
+  std::vector<std::string> file_names;
+  for (const QFileInfo& info : dir.entryInfoList(QStringList("*.yml"), QDir::Files, QDir::Name))
+  {
+    file_names.push_back(info.filePath().toStdString());
+  }
+  std::sort(file_names.begin(), file_names.end());
+
+  QCOMPARE(file_names.size(), n_builtin_objects);
+
+  QTest::addColumn<QString>("file_name");
+  QTest::addColumn<int>("index");
+
+  for (std::size_t i = 0; i < file_names.size(); i++)
+  {
+    QTest::newRow(file_names[i].c_str()) << QString::fromStdString(file_names[i]) << static_cast<int>(i);
+  }
+}
+
+void Test::tables_test()
+{
+  QFETCH(QString, file_name);
+  QFETCH(int, index);
+
+  const ObjectSchema expected = read_schema(file_name.toStdString());
+  const ObjectSchema builtin = to_schema(builtin_objects[index]);
+
+  QCOMPARE(builtin.name.str(), expected.name.str());
+  QCOMPARE(builtin.type.str(), expected.type.str());
+  QVERIFY(builtin.object_type == expected.object_type);
+  QCOMPARE(builtin.description, expected.description);
+  QCOMPARE(builtin.options.size(), expected.options.size());
+
+  for (std::size_t i = 0; i < expected.options.size(); i++)
+  {
+    const OptionSchema& option = builtin.options[i];
+    const OptionSchema& expected_option = expected.options[i];
+
+    QCOMPARE(option.name.str(), expected_option.name.str());
+    QCOMPARE(option.type.str(), expected_option.type.str());
+    QVERIFY(option.option_type == expected_option.option_type);
+    QCOMPARE(option.description, expected_option.description);
+    QVERIFY(option.values == expected_option.values);
+    QCOMPARE(option.has_default, expected_option.has_default);
+    QCOMPARE(option.default_value, expected_option.default_value);
+    QCOMPARE(option.required, expected_option.required);
+    QCOMPARE(option.minimum, expected_option.minimum);
+    QCOMPARE(option.maximum, expected_option.maximum);
+    QCOMPARE(option.pattern, expected_option.pattern);
+    QCOMPARE(option.path, expected_option.path);
+    QVERIFY(option.conflicts == expected_option.conflicts);
+    QVERIFY(option.dependencies == expected_option.dependencies);
+  }
+}
+
+QTEST_MAIN(Test)
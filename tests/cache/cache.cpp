@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "cache.h"
+#include "schemacache.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+#include <fstream>
+
+void Test::initTestCase()
+{
+  dir = std::make_unique<QTemporaryDir>();
+  QVERIFY(dir->isValid());
+
+  schema_file = dir->filePath("dst_cached.yml");
+  cache_file = dir->filePath("objects.cache");
+
+  write_schema("A destination of the cache test.");
+}
+
+void Test::cleanupTestCase()
+{
+  dir.reset();
+}
+
+void Test::miss_test()
+{
+  SchemaCache cache(cache_file);
+
+  ObjectSchema schema;
+  QVERIFY(!cache.find(QFileInfo(schema_file), schema));
+
+  cache.insert(QFileInfo(schema_file), read_schema(schema_file.toStdString()));
+  cache.save();
+
+  QVERIFY(QFile::exists(cache_file));
+}
+
+void Test::hit_test()
+{
+  SchemaCache cache(cache_file);
+
+  ObjectSchema schema;
+  QVERIFY(cache.find(QFileInfo(schema_file), schema));
+
+  QCOMPARE(schema.name.str(), std::string("cached"));
+  QCOMPARE(schema.type.str(), std::string("destination"));
+  QVERIFY(schema.object_type == ObjectType::DESTINATION);
+  QCOMPARE(schema.description, std::string("A destination of the cache test."));
+  QCOMPARE(schema.options.size(), std::size_t(3));
+
+  QCOMPARE(schema.options[0].name.str(), std::string("file"));
+  QVERIFY(schema.options[0].required);
+  QVERIFY(schema.options[0].path);
+  QVERIFY(schema.options[1].option_type == OptionType::NUMBER);
+  QVERIFY(schema.options[2].option_type == OptionType::LIST);
+  QCOMPARE(schema.options[1].minimum, 0);
+  QCOMPARE(schema.options[1].maximum, 65535);
+  QCOMPARE(schema.options[1].conflicts.size(), std::size_t(1));
+  QCOMPARE(schema.options[2].values.size(), std::size_t(2));
+  QCOMPARE(schema.options[2].default_value, std::string("tcp"));
+}
+
+void Test::stale_test()
+{
+  write_schema("A changed destination of the cache test.");
+
+  {
+    SchemaCache cache(cache_file);
+
+    ObjectSchema schema;
+    QVERIFY(!cache.find(QFileInfo(schema_file), schema));
+
+    cache.insert(QFileInfo(schema_file), read_schema(schema_file.toStdString()));
+    cache.save();
+  }
+
+  SchemaCache cache(cache_file);
+
+  ObjectSchema schema;
+  QVERIFY(cache.find(QFileInfo(schema_file), schema));
+  QCOMPARE(schema.description, std::string("A changed destination of the cache test."));
+}
+
+void Test::version_test()
+{
+  QFile file(cache_file);
+  QVERIFY(file.open(QIODevice::ReadOnly));
+  QByteArray contents = file.readAll();
+  file.close();
+
+  // the version follows the magic, the cache of an older build is rebuilt
+  const QString old_file = dir->filePath("old.cache");
+  contents[7] = contents[7] - 1;
+
+  QFile old(old_file);
+  QVERIFY(old.open(QIODevice::WriteOnly));
+  old.write(contents);
+  old.close();
+
+  SchemaCache cache(old_file);
+
+  ObjectSchema schema;
+  QVERIFY(!cache.find(QFileInfo(schema_file), schema));
+}
+
+void Test::corrupt_test()
+{
+  QFile file(cache_file);
+  QVERIFY(file.open(QIODevice::ReadOnly));
+  const QByteArray contents = file.readAll();
+  file.close();
+
+  const QString damaged_file = dir->filePath("damaged.cache");
+
+  // every byte overwritten and the file cut at every byte: the entry is found or not, nothing is thrown
+  for (int i = 0; i < contents.size(); i++)
+  {
+    for (const QByteArray& damaged : { contents.left(i), contents.left(i) + QByteArray(1, '\xff') + contents.mid(i + 1) })
+    {
+      QFile::remove(damaged_file);
+
+      QFile out(damaged_file);
+      QVERIFY(out.open(QIODevice::WriteOnly));
+      out.write(damaged);
+      out.close();
+
+      SchemaCache cache(damaged_file);
+
+      ObjectSchema schema;
+      cache.find(QFileInfo(schema_file), schema);
+    }
+  }
+}
+
+void Test::write_schema(const std::string& description)
+{
+  std::ofstream out(schema_file.toStdString());
+  out << "name: cached\n"
+         "type: destination\n"
+         "description: " << description << "\n"
+         "options:\n"
+         "  - file:\n"
+         "      type: string\n"
+         "      description: The file to write.\n"
+         "      required: yes\n"
+         "      path: yes\n"
+         "  - port:\n"
+         "      type: number\n"
+         "      description: The port to connect to.\n"
+         "      min: 0\n"
+         "      max: 65535\n"
+         "      conflicts: [file]\n"
+         "  - transport:\n"
+         "      type: list\n"
+         "      description: The transport protocol.\n"
+         "      values: [tcp, udp]\n"
+         "      default: tcp\n";
+}
+
+QTEST_MAIN(Test)
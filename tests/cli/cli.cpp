@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "cli.h"
+#include "description.h"
+#include "batch.h"
+#include "config.h"
+
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+static const std::string statements =
+  "statements:\n"
+  "  - id: s_local\n"
+  "    type: source\n"
+  "    objects:\n"
+  "      - name: internal\n"
+  "  - id: d_messages\n"
+  "    type: destination\n"
+  "    objects:\n"
+  "      - name: file\n"
+  "        options:\n"
+  "          file: /var/log/messages\n"
+  "          create-dirs: yes\n";
+
+void Test::description_test()
+{
+  Config config;
+  Description description(config);
+
+  description.load("options:\n"
+                   "  use-dns: no\n" +
+                   statements +
+                   "logs:\n"
+                   "  - statements: [s_local, d_messages]\n"
+                   "    options:\n"
+                   "      flags: final\n");
+
+  QCOMPARE(config.get_object_statements().size(), std::size_t(2));
+  QCOMPARE(config.get_log_statements().size(), std::size_t(1));
+
+  const std::string output = config.to_string();
+  QVERIFY(output.find("use-dns(no)") != std::string::npos);
+  QVERIFY(output.find("source s_local {") != std::string::npos);
+  QVERIFY(output.find("/var/log/messages") != std::string::npos);
+  QVERIFY(output.find("create-dirs(yes)") != std::string::npos);
+  QVERIFY(output.find("flags(final)") != std::string::npos);
+}
+
+void Test::not_map_test()
+{
+  QCOMPARE(load_error("- a\n- b\n"), std::string("the description is not a map"));
+  QCOMPARE(load_error("statements:\n"
+                      "  - id: d_messages\n"
+                      "    type: destination\n"
+                      "    objects:\n"
+                      "      - name: file\n"
+                      "        options: /var/log/messages\n"),
+           std::string("the options of file are not a map"));
+}
+
+void Test::unknown_option_test()
+{
+  QCOMPARE(load_error("statements:\n"
+                      "  - id: d_messages\n"
+                      "    type: destination\n"
+                      "    objects:\n"
+                      "      - name: file\n"
+                      "        options:\n"
+                      "          no-such-option: 1\n"),
+           std::string("unknown option of file: no-such-option"));
+
+  QCOMPARE(load_error("options:\n"
+                      "  no-such-option: 1\n"),
+           std::string("unknown option of global: no-such-option"));
+
+  // an Object that is not a default Object
+  QVERIFY_EXCEPTION_THROWN(load_error("statements:\n"
+                                      "  - id: d_messages\n"
+                                      "    type: destination\n"
+                                      "    objects:\n"
+                                      "      - name: no-such-object\n"),
+                           std::out_of_range);
+}
+
+void Test::invalid_list_value_test()
+{
+  QCOMPARE(load_error("statements:\n"
+                      "  - id: d_messages\n"
+                      "    type: destination\n"
+                      "    objects:\n"
+                      "      - name: file\n"
+                      "        options:\n"
+                      "          file: /var/log/messages\n"
+                      "          create-dirs: maybe\n"),
+           std::string("invalid value of file create-dirs: maybe"));
+}
+
+void Test::duplicate_id_test()
+{
+  QCOMPARE(load_error(statements +
+                      "  - id: s_local\n"
+                      "    type: source\n"
+                      "    objects:\n"
+                      "      - name: internal\n"),
+           std::string("duplicate statement id: s_local"));
+}
+
+void Test::unknown_id_test()
+{
+  QCOMPARE(load_error(statements +
+                      "logs:\n"
+                      "  - statements: [s_local, d_missing]\n"),
+           std::string("unknown statement id in log: d_missing"));
+}
+
+void Test::substitute_test()
+{
+  const Variables variables { { "host", "web1" }, { "port", "5140" } };
+  std::size_t n_variables = 0;
+
+  QCOMPARE(substitute("/var/log/{{host}}/messages", variables, &n_variables), std::string("/var/log/web1/messages"));
+  QCOMPARE(n_variables, std::size_t(1));
+
+  QCOMPARE(substitute("{{host}}:{{port}}", variables, &n_variables), std::string("web1:5140"));
+  QCOMPARE(n_variables, std::size_t(2));
+
+  // the macros of syslog-ng are not variables
+  QCOMPARE(substitute("${HOST} ${PROGRAM}: ${MESSAGE}", variables, &n_variables), std::string("${HOST} ${PROGRAM}: ${MESSAGE}"));
+  QCOMPARE(n_variables, std::size_t(0));
+
+  // unknown variables are left as they are
+  QCOMPARE(substitute("{{host}}-{{rack}}", variables, &n_variables), std::string("web1-{{rack}}"));
+  QCOMPARE(n_variables, std::size_t(2));
+
+  // escaped, or not a variable name
+  QCOMPARE(substitute("{{{{host}}", variables, &n_variables), std::string("{{host}}"));
+  QCOMPARE(n_variables, std::size_t(0));
+  QCOMPARE(substitute("{{ host }} {{}} {{host", variables, &n_variables), std::string("{{ host }} {{}} {{host"));
+  QCOMPARE(n_variables, std::size_t(0));
+}
+
+void Test::variables_test()
+{
+  Config config;
+  Description description(config);
+
+  description.load("statements:\n"
+                   "  - id: d_network\n"
+                   "    type: destination\n"
+                   "    objects:\n"
+                   "      - name: network\n"
+                   "        options:\n"
+                   "          network: \"{{host}}.example.com\"\n"
+                   "          port: \"{{port}}\"\n"
+                   "  - id: d_file\n"
+                   "    type: destination\n"
+                   "    objects:\n"
+                   "      - name: file\n"
+                   "        options:\n"
+                   "          file: /var/log/${HOST}/{{{{literal}}\n");
+
+  // the macro and the escaped braces are set as they are
+  const std::vector<ObjectVariables>& variables = description.get_variables();
+  QCOMPARE(variables.size(), std::size_t(1));
+  QCOMPARE(variables[0].object->get_name(), std::string("network"));
+  QCOMPARE(variables[0].values.size(), std::size_t(2));
+  QCOMPARE(variables[0].values[1].value, std::string("{{port}}"));
+
+  const std::string output = config.to_string();
+  QVERIFY(output.find("/var/log/${HOST}/{{literal}}") != std::string::npos);
+}
+
+void Test::batch_test()
+{
+  Config config;
+  Description description(config);
+
+  description.load("statements:\n"
+                   "  - id: d_network\n"
+                   "    type: destination\n"
+                   "    objects:\n"
+                   "      - name: network\n"
+                   "        options:\n"
+                   "          network: \"{{host}}.example.com\"\n"
+                   "          port: \"{{port}}\"\n"
+                   "          transport: \"{{transport}}\"\n"
+                   "          template: \"${HOST} {{rack}}\"\n");
+
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const std::string output_dir = dir.path().toStdString();
+
+  const std::vector<Variables> hosts {
+    { { "host", "web1" }, { "port", "5140" }, { "transport", "tls" } },
+    { { "host", "web2" }, { "port", "5141" }, { "transport", "udp" }, { "rack", "r2" } }
+  };
+
+  const Batch::Statistics statistics = Batch(config, description.get_variables()).run(hosts, output_dir, 2);
+  QCOMPARE(statistics.hosts, std::size_t(2));
+  QCOMPARE(statistics.copied_objects, std::size_t(2));
+
+  std::vector<std::string> outputs;
+  for (const Variables& host : hosts)
+  {
+    std::ifstream file(Batch::get_file_name(output_dir, host.at("host")));
+    std::stringstream text;
+    text << file.rdbuf();
+    outputs.push_back(text.str());
+  }
+
+  QVERIFY(outputs[0].find("web1.example.com") != std::string::npos);
+  QVERIFY(outputs[0].find("port(5140)") != std::string::npos);
+  QVERIFY(outputs[0].find("transport(tls)") != std::string::npos);
+  QVERIFY(outputs[0].find("${HOST} {{rack}}") != std::string::npos);
+
+  QVERIFY(outputs[1].find("web2.example.com") != std::string::npos);
+  QVERIFY(outputs[1].find("port(5141)") != std::string::npos);
+  QVERIFY(outputs[1].find("transport(udp)") != std::string::npos);
+  QVERIFY(outputs[1].find("${HOST} r2") != std::string::npos);
+}
+
+void Test::duplicate_host_test()
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const std::string file_name = dir.filePath("hosts.yml").toStdString();
+
+  {
+    std::ofstream file(file_name);
+    file << "- host: web1\n"
+            "  port: 5140\n"
+            "- host: web2\n"
+            "- port: 5141\n"
+            "  host: web1\n";
+  }
+
+  // both would be written to the same file
+  std::string error;
+  try
+  {
+    Batch::load_hosts(file_name);
+  }
+  catch (const std::runtime_error& e)
+  {
+    error = e.what();
+  }
+
+  QCOMPARE(error, file_name + ":5: duplicate host: web1, first on line 1");
+}
+
+void Test::invalid_substitution_test()
+{
+  Config config;
+  Description description(config);
+
+  description.load("statements:\n"
+                   "  - id: d_network\n"
+                   "    type: destination\n"
+                   "    objects:\n"
+                   "      - name: network\n"
+                   "        options:\n"
+                   "          network: \"{{host}}.example.com\"\n"
+                   "          port: \"{{port}}\"\n"
+                   "          transport: \"{{transport}}\"\n");
+
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+
+  const Batch batch(config, description.get_variables());
+
+  const std::vector< std::pair<Variables, std::string> > cases {
+    { { { "host", "web1" }, { "port", "51x" }, { "transport", "tcp" } }, "host web1: invalid value of network port: 51x" },
+    { { { "host", "web2" }, { "transport", "tcp" } }, "host web2: invalid value of network port: {{port}}" },
+    { { { "host", "web3" }, { "port", "99999999999" }, { "transport", "tcp" } }, "host web3: invalid value of network port: 99999999999" },
+    { { { "host", "web4" }, { "port", "5140" }, { "transport", "sctp" } }, "host web4: invalid value of network transport: sctp" }
+  };
+
+  for (const std::pair<Variables, std::string>& test_case : cases)
+  {
+    std::string message;
+    try
+    {
+      batch.run({ test_case.first }, dir.path().toStdString(), 1);
+    }
+    catch (const std::runtime_error& e)
+    {
+      message = e.what();
+    }
+
+    QCOMPARE(message, test_case.second);
+  }
+}
+
+std::string Test::load_error(const std::string& text)
+{
+  Config config;
+  Description description(config);
+
+  try
+  {
+    description.load(text);
+  }
+  catch (const std::runtime_error& e)
+  {
+    return e.what();
+  }
+
+  return std::string();
+}
+
+QTEST_MAIN(Test)
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CLI_H
+#define CLI_H
+
+#include <QObject>
+
+#include <string>
+
+class Test : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void description_test();
+  void not_map_test();
+  void unknown_option_test();
+  void invalid_list_value_test();
+  void duplicate_id_test();
+  void unknown_id_test();
+
+  void substitute_test();
+  void variables_test();
+  void batch_test();
+  void duplicate_host_test();
+  void invalid_substitution_test();
+
+private:
+  /*
+   * @return: returns the message of the exception thrown by loading @text, empty if it's loaded.
+   */
+  static std::string load_error(const std::string& text);
+};
+
+#endif  // CLI_H
@@ -0,0 +1,15 @@
+TEMPLATE = app
+CONFIG += c++17 testcase
+TARGET = cli
+MOC_DIR = ../build/moc
+OBJECTS_DIR = ../build/obj
+QT = core testlib
+include(../../core/core.pri)
+INCLUDEPATH += ../../cli
+
+SOURCES += \
+    cli.cpp \
+    ../../cli/description.cpp \
+    ../../cli/batch.cpp
+
+HEADERS += cli.h
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clone.h"
+#include "config.h"
+
+#include <QtTest/QTest>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// every allocation is counted, to report the memory used by a single copy
+static std::atomic<std::size_t> allocations(0);
+static std::atomic<std::size_t> allocated_bytes(0);
+
+void* operator new(std::size_t size)
+{
+  allocations++;
+  allocated_bytes += size;
+
+  void* pointer = std::malloc(size ? size : 1);
+  if (!pointer)
+  {
+    throw std::bad_alloc();
+  }
+
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void Test::clone_benchmark_data()
+{
+  QTest::addColumn<QString>("name");
+  QTest::addColumn<QString>("type");
+
+  QTest::newRow("file destination") << "file" << "destination";
+  QTest::newRow("network destination") << "network" << "destination";
+  QTest::newRow("syslog source") << "syslog" << "source";
+  QTest::newRow("match filter") << "match" << "filter";
+  QTest::newRow("global options") << "global" << "options";
+}
+
+void Test::clone_benchmark()
+{
+  static Config config;
+
+  QFETCH(QString, name);
+  QFETCH(QString, type);
+
+  const Object& default_object = config.get_default_object(name.toStdString(), type.toStdString());
+
+  const std::size_t allocations_before = allocations;
+  const std::size_t allocated_bytes_before = allocated_bytes;
+
+  std::unique_ptr<Object> object(default_object.clone());
+
+  qInfo("%s %s: %zu bytes in %zu allocations per copy, %zu options",
+        qPrintable(name), qPrintable(type),
+        allocated_bytes - allocated_bytes_before, allocations - allocations_before,
+        object->get_options().size());
+
+  // the same copy made by the configuration, the Object and its options come from the arena
+  const Arena::Statistics arena_before = config.get_allocation_statistics();
+  const std::size_t arena_allocations_before = allocations;
+  const std::size_t arena_allocated_bytes_before = allocated_bytes;
+
+  std::shared_ptr<Object> arena_object = config.create_object(name.toStdString(), type.toStdString());
+
+  const Arena::Statistics& arena_after = config.get_allocation_statistics();
+  qInfo("%s %s: %zu bytes in %zu arena allocations and %zu bytes in %zu allocations per copy, %zu peak arena bytes",
+        qPrintable(name), qPrintable(type),
+        arena_after.bytes - arena_before.bytes, arena_after.allocations - arena_before.allocations,
+        allocated_bytes - arena_allocated_bytes_before, allocations - arena_allocations_before,
+        arena_after.peak_bytes);
+
+  QBENCHMARK
+  {
+    std::shared_ptr<Object> copy = config.create_object(name.toStdString(), type.toStdString());
+  }
+}
+
+QTEST_MAIN(Test)
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SETOPTION_H
+#define SETOPTION_H
+
+#include "object.h"
+
+#include <string>
+
+/*
+ * Sets the current value of the option of @object named @name, does nothing if @object has no such option.
+ */
+inline void set_option(Object& object, const std::string& name, const std::string& value)
+{
+  for (Option& option : object.get_options())
+  {
+    if (option.get_name() == name)
+    {
+      option.set_current(value);
+      return;
+    }
+  }
+}
+
+#endif  // SETOPTION_H
@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "containers.h"
+#include "slotmap.h"
+#include "indexedvector.h"
+#include "config.h"
+
+#include <QtTest/QTest>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Counts the living instances, to check when the elements are destroyed.
+ */
+struct Counted
+{
+  static int instances;
+
+  Counted() { instances++; }
+  explicit Counted(bool fail) { if (fail) { throw std::runtime_error("not constructed"); } instances++; }
+  ~Counted() { instances--; }
+};
+
+int Counted::instances = 0;
+
+typedef IndexedVector< std::shared_ptr<const std::string> > StringVector;
+
+static std::vector<std::string> to_vector(const SlotMap<std::string>& map)
+{
+  return std::vector<std::string>(map.begin(), map.end());
+}
+
+/*
+ * @return: returns the elements of @vector, after checking that each one is found at its position.
+ */
+static std::vector<std::string> to_vector(const StringVector& vector)
+{
+  std::vector<std::string> strings;
+
+  for (std::size_t i = 0; i < vector.size(); i++)
+  {
+    if (vector.find(vector[i]) != i)
+    {
+      return {"wrong position of " + *vector[i]};
+    }
+
+    strings.push_back(*vector[i]);
+  }
+
+  return strings;
+}
+
+static StringVector make_vector(const std::shared_ptr<Arena>& arena, const std::vector< std::shared_ptr<const std::string> >& elements)
+{
+  StringVector vector(arena);
+
+  for (const std::shared_ptr<const std::string>& element : elements)
+  {
+    vector.insert(element, vector.size());
+  }
+
+  return vector;
+}
+
+void Test::slotmap_find_test()
+{
+  SlotMap<std::string> map;
+  QVERIFY(map.empty());
+
+  const SlotMap<std::string>::Handle a = map.emplace("a");
+  const SlotMap<std::string>::Handle b = map.emplace(3, 'b');
+
+  QCOMPARE(map.size(), std::size_t(2));
+  QCOMPARE(*map.find(a), std::string("a"));
+  QCOMPARE(*map.find(b), std::string("bbb"));
+
+  // a handle that was never given out
+  QVERIFY(!map.find(SlotMap<std::string>::Handle{2, 0}));
+  QVERIFY(!map.find(SlotMap<std::string>::Handle{a.index, a.generation + 1}));
+}
+
+void Test::slotmap_stale_handle_test()
+{
+  SlotMap<std::string> map;
+
+  const SlotMap<std::string>::Handle a = map.emplace("a");
+  const SlotMap<std::string>::Handle b = map.emplace("b");
+
+  QVERIFY(map.erase(a));
+  QVERIFY(!map.find(a));
+  QCOMPARE(*map.find(b), std::string("b"));
+  QCOMPARE(map.size(), std::size_t(1));
+
+  // erasing twice does nothing
+  QVERIFY(!map.erase(a));
+  QCOMPARE(map.size(), std::size_t(1));
+}
+
+void Test::slotmap_reuse_test()
+{
+  SlotMap<std::string> map;
+
+  const SlotMap<std::string>::Handle a = map.emplace("a");
+  map.emplace("b");
+  QVERIFY(map.erase(a));
+
+  // the slot of the erased element is taken with a new generation
+  const SlotMap<std::string>::Handle c = map.emplace("c");
+  QCOMPARE(c.index, a.index);
+  QVERIFY(c.generation != a.generation);
+
+  QVERIFY(!map.find(a));
+  QCOMPARE(*map.find(c), std::string("c"));
+
+  // the stale handle can't erase the new element
+  QVERIFY(!map.erase(a));
+  QCOMPARE(*map.find(c), std::string("c"));
+}
+
+void Test::slotmap_order_test()
+{
+  SlotMap<std::string> map;
+
+  const SlotMap<std::string>::Handle a = map.emplace("a");
+  const SlotMap<std::string>::Handle b = map.emplace("b");
+  map.emplace("c");
+  const SlotMap<std::string>::Handle d = map.emplace("d");
+  QCOMPARE(to_vector(map), std::vector<std::string>({"a", "b", "c", "d"}));
+
+  // a reused slot is iterated in insertion order, not in slot order
+  QVERIFY(map.erase(b));
+  map.emplace("e");
+  QCOMPARE(to_vector(map), std::vector<std::string>({"a", "c", "d", "e"}));
+
+  QVERIFY(map.erase(a));
+  QVERIFY(map.erase(d));
+  map.emplace("f");
+  QCOMPARE(to_vector(map), std::vector<std::string>({"c", "e", "f"}));
+}
+
+void Test::slotmap_destroy_test()
+{
+  {
+    SlotMap<Counted> map;
+
+    const SlotMap<Counted>::Handle a = map.emplace();
+    map.emplace();
+    map.emplace();
+    QCOMPARE(Counted::instances, 3);
+
+    QVERIFY(map.erase(a));
+    QCOMPARE(Counted::instances, 2);
+
+    map.clear();
+    QCOMPARE(Counted::instances, 0);
+    QVERIFY(map.empty());
+    QVERIFY(map.begin() == map.end());
+
+    map.emplace();
+    map.emplace();
+  }
+
+  QCOMPARE(Counted::instances, 0);
+}
+
+void Test::slotmap_throw_test()
+{
+  SlotMap<Counted> map;
+
+  QVERIFY_EXCEPTION_THROWN(map.emplace(true), std::runtime_error);
+  QCOMPARE(Counted::instances, 0);
+  QVERIFY(map.empty());
+  QVERIFY(map.begin() == map.end());
+
+  // the entry reserved for the failed element is taken by the next one
+  const SlotMap<Counted>::Handle a = map.emplace(false);
+  QCOMPARE(a.index, std::uint32_t(0));
+  QCOMPARE(map.size(), std::size_t(1));
+  QVERIFY(map.find(a));
+
+  QVERIFY_EXCEPTION_THROWN(map.emplace(true), std::runtime_error);
+  map.emplace(false);
+  QCOMPARE(map.size(), std::size_t(2));
+  QCOMPARE(Counted::instances, 2);
+
+  map.clear();
+  QCOMPARE(Counted::instances, 0);
+}
+
+void Test::indexedvector_insert_test()
+{
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+  StringVector vector(arena);
+
+  QVERIFY(vector.insert(std::make_shared<const std::string>("b"), 0));
+  QVERIFY(vector.insert(std::make_shared<const std::string>("d"), 1));
+  QVERIFY(vector.insert(std::make_shared<const std::string>("a"), 0));
+  QVERIFY(vector.insert(std::make_shared<const std::string>("c"), 2));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"a", "b", "c", "d"}));
+
+  // past the end is appended
+  QVERIFY(vector.insert(std::make_shared<const std::string>("e"), 100));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"a", "b", "c", "d", "e"}));
+}
+
+void Test::indexedvector_erase_test()
+{
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+  const auto a = std::make_shared<const std::string>("a");
+  const auto b = std::make_shared<const std::string>("b");
+  const auto c = std::make_shared<const std::string>("c");
+  const auto d = std::make_shared<const std::string>("d");
+  StringVector vector = make_vector(arena, {a, b, c, d});
+
+  QVERIFY(vector.erase(b));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"a", "c", "d"}));
+  QVERIFY(!vector.contains(b));
+  QCOMPARE(vector.find(b), vector.size());
+
+  // erasing twice does nothing
+  QVERIFY(!vector.erase(b));
+  QCOMPARE(vector.size(), std::size_t(3));
+
+  QVERIFY(vector.erase(d));
+  QVERIFY(vector.erase(a));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"c"}));
+
+  // an erased element can be inserted again
+  QVERIFY(vector.insert(a, 0));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"a", "c"}));
+}
+
+void Test::indexedvector_move_test()
+{
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+  const auto a = std::make_shared<const std::string>("a");
+  const auto b = std::make_shared<const std::string>("b");
+  const auto c = std::make_shared<const std::string>("c");
+  const auto d = std::make_shared<const std::string>("d");
+  const auto e = std::make_shared<const std::string>("e");
+  StringVector vector = make_vector(arena, {a, b, c, d, e});
+
+  // forward, the elements in between shift back
+  QVERIFY(vector.move(b, 3));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"a", "c", "d", "b", "e"}));
+
+  // backward, the elements in between shift forward
+  QVERIFY(vector.move(e, 0));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"e", "a", "c", "d", "b"}));
+
+  // past the end moves to the last position
+  QVERIFY(vector.move(a, 100));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"e", "c", "d", "b", "a"}));
+
+  // to its own position, or past the end from the last one, changes nothing
+  QVERIFY(!vector.move(d, 2));
+  QVERIFY(!vector.move(a, 100));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"e", "c", "d", "b", "a"}));
+
+  QVERIFY(vector.erase(c));
+  QVERIFY(!vector.move(c, 0));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"e", "d", "b", "a"}));
+}
+
+void Test::indexedvector_duplicate_test()
+{
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+  const auto a = std::make_shared<const std::string>("a");
+  StringVector vector = make_vector(arena, {a});
+
+  QVERIFY(!vector.insert(a, 0));
+  QVERIFY(!vector.insert(a, 1));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"a"}));
+
+  // the elements are told apart by identity, not by value
+  QVERIFY(vector.insert(std::make_shared<const std::string>("a"), 1));
+  QCOMPARE(to_vector(vector), std::vector<std::string>({"a", "a"}));
+  QCOMPARE(vector.find(a), std::size_t(0));
+}
+
+void Test::arena_reset_test()
+{
+  Arena arena;
+
+  void* block = arena.allocate(64, 8);
+  QVERIFY(!arena.reset());
+  QCOMPARE(arena.get_statistics().live_allocations, std::size_t(1));
+
+  arena.deallocate(block, 64, 8);
+  QVERIFY(arena.reset());
+  QCOMPARE(arena.get_statistics().live_allocations, std::size_t(0));
+  QCOMPARE(arena.get_statistics().bytes, std::size_t(0));
+
+  // the arena can be used again after a reset
+  block = arena.allocate(64, 8);
+  QVERIFY(block);
+  arena.deallocate(block, 64, 8);
+}
+
+void Test::arena_large_block_test()
+{
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+
+  {
+    std::vector< int, ArenaAllocator<int> > vector{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 100000; i++)
+    {
+      vector.push_back(i);
+    }
+
+    // the buffers the vector outgrew are freed, only its last one is in use, and it's not in the pool
+    QCOMPARE(arena->get_statistics().live_allocations, std::size_t(1));
+    QCOMPARE(arena->get_statistics().bytes, vector.capacity() * sizeof(int));
+    QVERIFY(arena->reset());
+  }
+
+  QCOMPARE(arena->get_statistics().bytes, std::size_t(0));
+}
+
+void Test::config_release_memory_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement("d_file");
+  object_statement->add_object(config.create_object("file", "destination"), 0);
+
+  QVERIFY(!config.release_memory());
+
+  object_statement.reset();
+  QCOMPARE(config.get_allocation_statistics().live_allocations, std::size_t(0));
+  QVERIFY(config.release_memory());
+
+  // a new configuration in the same Config
+  object_statement = config.add_object_statement("d_file");
+  object_statement->add_object(config.create_object("file", "destination"), 0);
+  QVERIFY(config.to_string().find("d_file") != std::string::npos);
+}
+
+QTEST_MAIN(Test)
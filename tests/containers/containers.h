@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CONTAINERS_H
+#define CONTAINERS_H
+
+#include <QObject>
+
+class Test : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void slotmap_find_test();
+  void slotmap_stale_handle_test();
+  void slotmap_reuse_test();
+  void slotmap_order_test();
+  void slotmap_destroy_test();
+  void slotmap_throw_test();
+
+  void indexedvector_insert_test();
+  void indexedvector_erase_test();
+  void indexedvector_move_test();
+  void indexedvector_duplicate_test();
+
+  void arena_reset_test();
+  void arena_large_block_test();
+  void config_release_memory_test();
+};
+
+#endif  // CONTAINERS_H
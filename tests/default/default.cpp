@@ -20,6 +20,7 @@
 
 #include "default.h"
 #include "config.h"
+#include "setoption.h"
 
 #include <QString>
 #include <QFile>
@@ -278,33 +279,14 @@ void Test::is_config_valid_test()
   QCOMPARE(QString::fromStdString(config.to_string()), conf);
 }
 
-void Test::set_option(Object& object, const std::string& option_name, const std::string& option_value)
-{
-  std::vector< std::unique_ptr<Option> >& options = object.get_options();
-  auto it = std::find_if(options.begin(), options.end(),
-                         [&option_name](std::unique_ptr<Option>& option)->bool {
-                           return option->get_name() == option_name;
-                         });
-
-  if (it != options.end())
-  {
-    std::unique_ptr<Option>& option = *it;
-    option->set_current(option_value);
-  }
-}
-
 std::shared_ptr<Object> Test::add_object(Config& config, const std::string& object_name, const std::string& object_type)
 {
-  const Object& default_object = config.get_default_object(object_name, object_type);
-  Object* object = default_object.clone();
-
-  return std::shared_ptr<Object>(object);
+  return config.create_object(object_name, object_type);
 }
 
 std::shared_ptr<ObjectStatement>& Test::add_object_statement(Config& config, const std::string& object_statement_id)
 {
-  ObjectStatement* new_object_statement = new ObjectStatement(object_statement_id);
-  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(new_object_statement);
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(object_statement_id);
 
   object_statements.push_back(std::move(object_statement));
 
@@ -313,10 +295,7 @@ std::shared_ptr<ObjectStatement>& Test::add_object_statement(Config& config, con
 
 void Test::add_object_statements_to_log_statement(Config& config, const std::vector<std::string>& object_statement_ids)
 {
-  const Options& options = static_cast<const Options&>(config.get_default_object("log", "options"));
-  LogStatement* new_log_statement = new LogStatement(options);
-
-  std::shared_ptr<LogStatement> log_statement = config.add_log_statement(new_log_statement);
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
 
   int i = 0;
   for (const std::string& id : object_statement_ids)
@@ -1,15 +1,14 @@
 TEMPLATE = app
-CONFIG += c++14 testcase
+CONFIG += c++17 testcase
 TARGET = default
-INCLUDEPATH += ../../src
 MOC_DIR = ../build/moc
 OBJECTS_DIR = ../build/obj
-QT += widgets testlib
-LIBS += -lyaml-cpp ../../build/obj/dialog.o ../../build/obj/option.o ../../build/obj/object.o ../../build/obj/config.o
+QT = core testlib
+include(../../core/core.pri)
+
+INCLUDEPATH += ../common
 
 SOURCES += default.cpp
 
-HEADERS += \
-    default.h \
-    ../../src/dialog.h
+HEADERS += default.h ../common/setoption.h
 
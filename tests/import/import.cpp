@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "import.h"
+#include "importer.h"
+#include "config.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QtTest/QTest>
+
+#include <fstream>
+#include <stdexcept>
+
+// a generated configuration of a few megabytes for the benchmark
+static const int n_log_statements = 5000;
+
+static void write_file(const QString& file_name, const std::string& text)
+{
+  std::ofstream file(file_name.toStdString(), std::ios::binary);
+  file << text;
+}
+
+static bool contains(const std::string& string, const std::string& part)
+{
+  return string.find(part) != std::string::npos;
+}
+
+void Test::initTestCase()
+{
+  for (int i = 0; i < n_log_statements; i++)
+  {
+    const std::string n = std::to_string(i);
+
+    generated += "source s_" + n + " {\n    syslog(ip(\"10.0.0." + n + "\") port(514) transport(\"tcp\"));\n};\n\n";
+    generated += "filter f_" + n + " {\n    not facility(auth, authpriv) and level(info..emerg) or match(\"" + n + "\" value(\"MESSAGE\"));\n};\n\n";
+    generated += "destination d_" + n + " {\n    file(\"/var/log/" + n + "/messages\" perm(0640) create-dirs(yes));\n};\n\n";
+    generated += "log {\n    source(s_" + n + ");\n    filter(f_" + n + ");\n    destination(d_" + n + ");\n    flags(final);\n};\n\n";
+  }
+}
+
+void Test::round_trip_test_data()
+{
+  QTest::addColumn<QString>("file_name");
+
+  QTest::newRow("default config") << "../default/default.conf";
+  QTest::newRow("sources config") << "../sources/sources.conf";
+}
+
+void Test::round_trip_test()
+{
+  QFETCH(QString, file_name);
+
+  QFile file(file_name);
+  file.open(QIODevice::ReadOnly | QIODevice::Text);
+
+  QTextStream in(&file);
+  QString conf = in.readAll();
+
+  file.close();
+
+  Config config;
+  Importer importer(config);
+  importer.import_file(file_name.toStdString());
+
+  // scl.conf is part of syslog-ng, not of the test
+  QCOMPARE(importer.get_unresolved_includes().size(), std::size_t(1));
+  QCOMPARE(QString::fromStdString(config.to_string()), conf);
+}
+
+void Test::quotes_test()
+{
+  const std::string text =
+    "destination d_quotes {\n"
+    "    file('/var/log/\"quoted\".log' template('a\\d') template-escape(yes));\n"
+    "};\n"
+    "destination d_escapes {\n"
+    "    file(\"/var/log/a\\\"b.log\" template(\"$MSG\\n\"));\n"
+    "};\n";
+
+  Config config;
+  Importer importer(config);
+  importer.import_text(text, "quotes.conf");
+
+  // a single quoted value has no escape sequences, it's escaped to be written between double quotes
+  const std::string output = config.to_string();
+  QVERIFY(contains(output, "file(\"/var/log/\\\"quoted\\\".log\""));
+  QVERIFY(contains(output, "template(\"a\\\\d\")"));
+
+  // a double quoted value is written back as it is
+  QVERIFY(contains(output, "file(\"/var/log/a\\\"b.log\""));
+  QVERIFY(contains(output, "template(\"$MSG\\n\")"));
+
+  // and the output reads back the same
+  Config reread;
+  Importer reimporter(reread);
+  reimporter.import_text(output, "output.conf");
+  QCOMPARE(reread.to_string(), output);
+}
+
+void Test::include_test()
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+
+  QVERIFY(QDir(dir.path()).mkpath("conf.d"));
+  QVERIFY(QDir(dir.path()).mkpath("glob"));
+
+  write_file(dir.filePath("main.conf"),
+             "@version: 3.7\n"
+             "@include \"scl.conf\"\n"
+             "@include \"sources.conf\"\n"
+             "@include 'conf.d'\n"
+             "@include \"glob/*.conf\"\n"
+             "log { source(s_local); destination(d_b); destination(d_a); destination(d_glob); };\n");
+  write_file(dir.filePath("sources.conf"), "source s_local { internal(); };\n");
+
+  // the files of a directory in the order of their names
+  write_file(dir.filePath("conf.d/2.conf"), "destination d_b { file(\"/var/log/b\"); };\n");
+  write_file(dir.filePath("conf.d/1.conf"), "destination d_a { file(\"/var/log/a\"); };\n");
+
+  write_file(dir.filePath("glob/match.conf"), "destination d_glob { file(\"/var/log/glob\"); };\n");
+  write_file(dir.filePath("glob/skipped.txt"), "this is not a configuration file\n");
+
+  Config config;
+  Importer importer(config);
+  importer.import_file(dir.filePath("main.conf").toStdString());
+
+  QCOMPARE(importer.get_unresolved_includes(), std::vector<std::string>({ "scl.conf" }));
+
+  std::vector<std::string> ids;
+  for (const std::shared_ptr<ObjectStatement>& object_statement : importer.get_object_statements())
+  {
+    ids.push_back(object_statement->get_id());
+  }
+  QCOMPARE(ids, std::vector<std::string>({ "s_local", "d_a", "d_b", "d_glob" }));
+
+  QCOMPARE(importer.get_log_statements().size(), std::size_t(1));
+  QCOMPARE(importer.get_log_statements()[0]->get_object_statements().size(), std::size_t(4));
+}
+
+void Test::include_depth_test()
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+
+  write_file(dir.filePath("loop.conf"), "@include \"loop.conf\"\n");
+
+  Config config;
+  Importer importer(config);
+
+  std::string message;
+  try
+  {
+    importer.import_file(dir.filePath("loop.conf").toStdString());
+  }
+  catch (const std::runtime_error& e)
+  {
+    message = e.what();
+  }
+
+  QVERIFY(contains(message, "@include nested too deep"));
+
+  QVERIFY_EXCEPTION_THROWN(importer.import_file(dir.filePath("missing.conf").toStdString()), std::runtime_error);
+}
+
+void Test::forward_reference_test()
+{
+  Config config;
+  Importer importer(config);
+  importer.import_text("log { source(s_local); filter(f_error); destination(d_messages); };\n"
+                       "source s_local { internal(); };\n"
+                       "filter f_error { level(err); };\n"
+                       "destination d_messages { file(\"/var/log/messages\"); };\n",
+                       "forward.conf");
+
+  QCOMPARE(importer.get_log_statements().size(), std::size_t(1));
+
+  std::vector<std::string> ids;
+  for (const std::shared_ptr<const ObjectStatement>& object_statement : importer.get_log_statements()[0]->get_object_statements())
+  {
+    ids.push_back(object_statement->get_id());
+  }
+  QCOMPARE(ids, std::vector<std::string>({ "s_local", "f_error", "d_messages" }));
+}
+
+void Test::parse_error_test_data()
+{
+  QTest::addColumn<QString>("text");
+  QTest::addColumn<QString>("message");
+
+  QTest::newRow("unterminated string") << "destination d { file(\"/var/log);\n};\n"
+                                       << "error.conf:1: unterminated string";
+  QTest::newRow("end of the file") << "destination d { file(\"/var/log\""
+                                   << "error.conf:1: unexpected end of the file";
+  QTest::newRow("missing semicolon") << "source s { internal(); }\nsource t { internal(); };\n"
+                                     << "error.conf:2: expected ; before source";
+  QTest::newRow("unsupported statement") << "block source b() { internal(); };\n"
+                                         << "error.conf:1: unsupported statement: block";
+  QTest::newRow("duplicate id") << "source s { internal(); };\nsource s { internal(); };\n"
+                                << "error.conf:2: duplicate statement id: s";
+  QTest::newRow("unknown driver") << "source s { nothing(); };\n"
+                                  << "error.conf:1: unknown source: nothing";
+  QTest::newRow("unknown option") << "destination d { file(\"/var/log\" nothing(1)); };\n"
+                                  << "error.conf:1: unknown option of file: nothing";
+  QTest::newRow("invalid number") << "destination d { file(\"/var/log\" log-fifo-size(1x)); };\n"
+                                  << "error.conf:1: invalid number of log-fifo-size: 1x";
+  QTest::newRow("invalid list value") << "destination d { file(\"/var/log\" create-dirs(maybe)); };\n"
+                                      << "error.conf:1: invalid value of create-dirs: maybe";
+  QTest::newRow("missing value") << "destination d { file(\"/var/log\" create-dirs()); };\n"
+                                 << "error.conf:1: missing value of create-dirs";
+  QTest::newRow("unknown log member") << "log { source(s_missing); };\n"
+                                      << "error.conf:1: unknown statement: s_missing";
+  QTest::newRow("wrong log member type") << "source s { internal(); };\nlog {\n destination(s);\n};\n"
+                                         << "error.conf:3: s is a source, not a destination";
+}
+
+void Test::parse_error_test()
+{
+  QFETCH(QString, text);
+  QFETCH(QString, message);
+
+  Config config;
+  Importer importer(config);
+
+  std::string error;
+  try
+  {
+    importer.import_text(text.toStdString(), "error.conf");
+  }
+  catch (const std::runtime_error& e)
+  {
+    error = e.what();
+  }
+
+  QCOMPARE(QString::fromStdString(error), message);
+}
+
+void Test::import_benchmark()
+{
+  QBENCHMARK
+  {
+    Config config;
+    Importer importer(config);
+    importer.import_text(generated, "generated.conf");
+
+    QCOMPARE(importer.get_log_statements().size(), std::size_t(n_log_statements));
+  }
+}
+
+QTEST_MAIN(Test)
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef IMPORT_H
+#define IMPORT_H
+
+#include <QObject>
+
+#include <string>
+
+class Test : public QObject
+{
+  Q_OBJECT
+
+  std::string generated;
+
+private slots:
+  void initTestCase();
+
+  void round_trip_test_data();
+  void round_trip_test();
+
+  void quotes_test();
+  void include_test();
+  void include_depth_test();
+  void forward_reference_test();
+
+  void parse_error_test_data();
+  void parse_error_test();
+
+  void import_benchmark();
+};
+
+#endif  // IMPORT_H
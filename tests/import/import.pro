@@ -0,0 +1,12 @@
+TEMPLATE = app
+CONFIG += c++17 testcase
+TARGET = import
+MOC_DIR = ../build/moc
+OBJECTS_DIR = ../build/obj
+QT = core testlib
+include(../../core/core.pri)
+
+SOURCES += import.cpp
+
+HEADERS += import.h
+
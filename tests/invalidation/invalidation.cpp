@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "invalidation.h"
+#include "config.h"
+#include "sink.h"
+#include "setoption.h"
+
+#include <QtTest/QTest>
+
+static bool contains(const std::string& string, const std::string& part)
+{
+  return string.find(part) != std::string::npos;
+}
+
+void Test::edit_test()
+{
+  Config config;
+  std::uint64_t generation = config.get_generation();
+
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_file");
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  std::shared_ptr<Object> first = config.create_object("file", "destination");
+  std::shared_ptr<Object> second = config.create_object("file", "destination");
+  destination->add_object(first, 0);
+  destination->add_object(second, 1);
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  set_option(*first, "file", "/var/log/first");
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  destination->move_object(second, 0);
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  destination->remove_object(second);
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  // a removed Object is detached until it's added again
+  set_option(*second, "file", "/var/log/second");
+  QCOMPARE(config.get_generation(), generation);
+
+  destination->add_object(second, 1);
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  set_option(*second, "file", "/var/log/other");
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+  log_statement->add_object_statement(destination, 0);
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  set_option(log_statement->get_options(), "flags", "final");
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  set_option(config.get_global_options(), "use-dns", "no");
+  QVERIFY(config.get_generation() > generation);
+  generation = config.get_generation();
+
+  log_statement.reset();
+  QVERIFY(config.get_generation() > generation);
+}
+
+void Test::unchanged_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_file");
+  std::shared_ptr<Object> object = config.create_object("file", "destination");
+  destination->add_object(object, 0);
+  set_option(*object, "file", "/var/log/messages");
+
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+  log_statement->add_object_statement(destination, 0);
+
+  std::shared_ptr<Object> other = config.create_object("file", "destination");
+  std::shared_ptr<ObjectStatement> other_statement = config.add_object_statement("d_other");
+
+  const std::uint64_t generation = config.get_generation();
+
+  // setting the same value, writing and reading change nothing
+  set_option(*object, "file", "/var/log/messages");
+  config.to_string();
+  config.get_default_object("file", "destination").to_string();
+
+  // neither do moves to the same position, or of elements that are not there
+  destination->move_object(object, 0);
+  destination->move_object(other, 0);
+  log_statement->move_object_statement(destination, 1);
+  log_statement->move_object_statement(other_statement, 0);
+
+  QCOMPARE(config.get_generation(), generation);
+}
+
+void Test::render_cache_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_file");
+  std::shared_ptr<Object> object = config.create_object("file", "destination");
+  destination->add_object(object, 0);
+  set_option(*object, "file", "/var/log/first");
+
+  const std::string first = config.to_string();
+  QVERIFY(contains(first, "/var/log/first"));
+  QCOMPARE(config.to_string(), first);
+
+  // the cached output of the edited Object is dropped
+  set_option(*object, "file", "/var/log/second");
+  QVERIFY(contains(object->to_string(), "/var/log/second"));
+
+  const std::string second = config.to_string();
+  QVERIFY(contains(second, "/var/log/second"));
+  QVERIFY(!contains(second, "/var/log/first"));
+
+  set_option(*object, "file", "/var/log/first");
+  QCOMPARE(config.to_string(), first);
+
+  destination->remove_object(object);
+  QVERIFY(!contains(config.to_string(), "/var/log/first"));
+}
+
+void Test::statement_cache_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> statement = config.add_object_statement("s_net");
+  std::shared_ptr<Object> source = config.create_object("network", "source");
+  statement->add_object(source, 0);
+  set_option(*source, "port", "514");
+
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+  log_statement->add_object_statement(statement, 0);
+  QVERIFY(contains(config.to_string(), "source(s_net);"));
+
+  // the LogStatement writes the new type of its ObjectStatement
+  std::shared_ptr<Object> destination = config.create_object("file", "destination");
+  statement->remove_object(source);
+  statement->add_object(destination, 0);
+
+  const std::string output = config.to_string();
+  QVERIFY(contains(output, "destination s_net {"));
+  QVERIFY(contains(output, "destination(s_net);"));
+  QVERIFY(!contains(output, "source(s_net);"));
+
+  // a substitute is written in place of the cached output, which is kept
+  std::shared_ptr<Object> copy = destination->clone(nullptr);
+  set_option(*copy, "file", "/var/log/copy");
+  const Substitutions substitutions = { { destination.get(), copy.get() } };
+
+  std::string substituted;
+  StringSink sink(substituted);
+  config.write(sink, 1, &substitutions);
+  QVERIFY(contains(substituted, "/var/log/copy"));
+  QCOMPARE(config.to_string(), output);
+}
+
+void Test::removed_outlives_test()
+{
+  std::shared_ptr<Object> object;
+
+  {
+    Config config;
+
+    std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_file");
+    object = config.create_object("file", "destination");
+    destination->add_object(object, 0);
+  }
+
+  // the ObjectStatement detached it when it was destroyed
+  QVERIFY(!object->get_generation().get_parent());
+  set_option(*object, "file", "/var/log/kept");
+  QVERIFY(contains(object->to_string(), "/var/log/kept"));
+}
+
+void Test::shared_object_test()
+{
+  Config config;
+
+  // a project file can hold one Object in several ObjectStatements
+  std::shared_ptr<ObjectStatement> first = config.add_object_statement("d_first");
+  std::shared_ptr<ObjectStatement> second = config.add_object_statement("d_second");
+  std::shared_ptr<Object> object = config.create_object("file", "destination");
+  first->add_object(object, 0);
+  second->add_object(object, 0);
+  set_option(*object, "file", "/var/log/old");
+  QVERIFY(contains(config.to_string(), "/var/log/old"));
+
+  // both ObjectStatements write the edited Object
+  set_option(*object, "file", "/var/log/new");
+  std::string output = config.to_string();
+  QVERIFY(!contains(output, "/var/log/old"));
+  QVERIFY(contains(output.substr(output.find("d_second")), "/var/log/new"));
+
+  // removed from one, it still counts in the Config through the other
+  second->remove_object(object);
+  std::uint64_t generation = config.get_generation();
+  set_option(*object, "file", "/var/log/first");
+  QVERIFY(config.get_generation() > generation);
+  QVERIFY(contains(config.to_string(), "/var/log/first"));
+
+  first->remove_object(object);
+  generation = config.get_generation();
+  set_option(*object, "file", "/var/log/none");
+  QCOMPARE(config.get_generation(), generation);
+}
+
+void Test::copy_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_file");
+  std::shared_ptr<Object> object = config.create_object("file", "destination");
+  destination->add_object(object, 0);
+  set_option(*object, "file", "/var/log/original");
+
+  const std::string output = object->to_string();
+  const std::uint64_t generation = config.get_generation();
+  const std::uint64_t object_generation = object->get_generation().get();
+
+  // the copy has the output of the original until it's edited, but it's not part of the Config
+  std::shared_ptr<Object> copy = object->clone(nullptr);
+  QCOMPARE(copy->to_string(), output);
+  QVERIFY(!copy->get_generation().get_parent());
+
+  set_option(*copy, "file", "/var/log/copy");
+  QVERIFY(contains(copy->to_string(), "/var/log/copy"));
+
+  QCOMPARE(config.get_generation(), generation);
+  QCOMPARE(object->get_generation().get(), object_generation);
+  QCOMPARE(object->to_string(), output);
+}
+
+void Test::copy_outlives_test()
+{
+  std::shared_ptr<Object> copy;
+
+  {
+    Config config;
+
+    std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_file");
+    std::shared_ptr<Object> object = config.create_object("file", "destination");
+    destination->add_object(object, 0);
+
+    copy = object->clone(nullptr);
+  }
+
+  // nothing of the Config is touched
+  set_option(*copy, "file", "/var/log/copy");
+  QVERIFY(contains(copy->to_string(), "/var/log/copy"));
+}
+
+QTEST_MAIN(Test)
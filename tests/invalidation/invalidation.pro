@@ -0,0 +1,14 @@
+TEMPLATE = app
+CONFIG += c++17 testcase
+TARGET = invalidation
+MOC_DIR = ../build/moc
+OBJECTS_DIR = ../build/obj
+QT = core testlib
+include(../../core/core.pri)
+
+INCLUDEPATH += ../common
+
+SOURCES += invalidation.cpp
+
+HEADERS += invalidation.h ../common/setoption.h
+
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "lint.h"
+#include "linter.h"
+#include "config.h"
+#include "setoption.h"
+
+#include <QtTest/QTest>
+
+// the log paths of the benchmark, each with its own source, filter and file destination
+static const int n_log_statements = 5000;
+
+void Test::unused_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> source = config.add_object_statement("s_local");
+  add_object(config, *source, "internal", "source");
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_messages");
+  add_object(config, *destination, "file", "destination");
+
+  std::shared_ptr<ObjectStatement> unused = config.add_object_statement("f_auth");
+  add_object(config, *unused, "facility", "filter");
+  std::shared_ptr<ObjectStatement> format = config.add_object_statement("t_format");
+  add_object(config, *format, "template", "template");
+
+  std::shared_ptr<LogStatement> log_statement = add_log(config, { source, destination });
+
+  QCOMPARE(lint_lines(config), std::string("filter f_auth: is not used in any log path\n"));
+
+  log_statement->add_object_statement(unused, 1);
+  QCOMPARE(lint_lines(config), std::string());
+}
+
+void Test::empty_log_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_messages");
+  add_object(config, *destination, "file", "destination");
+
+  std::shared_ptr<LogStatement> empty = add_log(config, {});
+  std::shared_ptr<LogStatement> no_source = add_log(config, { destination });
+  std::shared_ptr<LogStatement> catchall = add_log(config, { destination }, "catchall");
+
+  QCOMPARE(lint_lines(config), std::string("log #1: is empty\n"
+                                           "log #2: has no source and no catchall flag, it never receives messages\n"));
+}
+
+void Test::filter_test()
+{
+  Config config;
+
+  // facility(auth) and not facility(auth)
+  std::shared_ptr<ObjectStatement> never = config.add_object_statement("f_never");
+  std::shared_ptr<Object> first = add_object(config, *never, "facility", "filter");
+  set_option(*first, "facility", "auth");
+  static_cast<Filter&>(*first).set_next("and");
+  std::shared_ptr<Object> second = add_object(config, *never, "facility", "filter");
+  set_option(*second, "facility", "auth");
+  static_cast<Filter&>(*second).set_invert(true);
+
+  // facility(auth) and not facility(auth) or level(err)
+  std::shared_ptr<ObjectStatement> sometimes = config.add_object_statement("f_sometimes");
+  first = add_object(config, *sometimes, "facility", "filter");
+  set_option(*first, "facility", "auth");
+  static_cast<Filter&>(*first).set_next("and");
+  second = add_object(config, *sometimes, "facility", "filter");
+  set_option(*second, "facility", "auth");
+  static_cast<Filter&>(*second).set_invert(true);
+  static_cast<Filter&>(*second).set_next("or");
+  set_option(*add_object(config, *sometimes, "level", "filter"), "level", "err");
+
+  // facility(auth) and not facility(kern)
+  std::shared_ptr<ObjectStatement> different = config.add_object_statement("f_different");
+  first = add_object(config, *different, "facility", "filter");
+  set_option(*first, "facility", "auth");
+  static_cast<Filter&>(*first).set_next("and");
+  second = add_object(config, *different, "facility", "filter");
+  set_option(*second, "facility", "kern");
+  static_cast<Filter&>(*second).set_invert(true);
+
+  std::shared_ptr<ObjectStatement> source = config.add_object_statement("s_local");
+  add_object(config, *source, "internal", "source");
+  std::shared_ptr<LogStatement> log_statement = add_log(config, { source, never, sometimes, different });
+
+  const std::vector<LintDiagnostic> diagnostics = lint(config);
+
+  QCOMPARE(diagnostics.size(), std::size_t(1));
+  QCOMPARE(diagnostics[0].check, LintCheck::UNMATCHABLE_FILTER);
+  QCOMPARE(diagnostics[0].object_statement, static_cast<const ObjectStatement*>(never.get()));
+  QCOMPARE(diagnostics[0].position, std::size_t(1));
+  QCOMPARE(diagnostics[0].location, std::string("filter f_never, object 2"));
+}
+
+void Test::duplicate_file_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> source = config.add_object_statement("s_local");
+  add_object(config, *source, "internal", "source");
+
+  std::shared_ptr<ObjectStatement> messages = config.add_object_statement("d_messages");
+  set_option(*add_object(config, *messages, "file", "destination"), "file", "/var/log/messages");
+  set_option(*add_object(config, *messages, "file", "destination"), "file", "/var/log/$HOST/messages");
+
+  std::shared_ptr<ObjectStatement> copy = config.add_object_statement("d_copy");
+  set_option(*add_object(config, *copy, "network", "destination"), "network", "10.0.0.1");
+  set_option(*add_object(config, *copy, "file", "destination"), "file", "/var/log/messages");
+
+  std::shared_ptr<LogStatement> log_statement = add_log(config, { source, messages, copy });
+
+  QCOMPARE(lint_lines(config),
+           std::string("destination d_copy, object 2: writes \"/var/log/messages\" like destination d_messages, object 1\n"));
+}
+
+void Test::final_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> local = config.add_object_statement("s_local");
+  add_object(config, *local, "internal", "source");
+  std::shared_ptr<ObjectStatement> network = config.add_object_statement("s_network");
+  add_object(config, *network, "network", "source");
+  std::shared_ptr<ObjectStatement> auth = config.add_object_statement("f_auth");
+  set_option(*add_object(config, *auth, "facility", "filter"), "facility", "auth");
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_messages");
+  add_object(config, *destination, "file", "destination");
+
+  const std::vector< std::shared_ptr<LogStatement> > log_statements = {
+    add_log(config, { local, auth, destination }, "final"),  // filtered, doesn't take every message
+    add_log(config, { local, destination }, "final"),
+    add_log(config, { local, destination }),  // shadowed by #2
+    add_log(config, { local, network, destination }),  // still gets the messages of s_network
+    add_log(config, { local, destination }, "fallback"),
+    add_log(config, { destination }, "catchall"),  // gets s_network
+    add_log(config, { network, destination }, "final"),
+    add_log(config, { network, local, destination })  // shadowed by #2 and #7
+  };
+
+  QCOMPARE(lint_lines(config), std::string("log #3: never receives messages, the final flag of log #2 takes them\n"
+                                           "log #8: never receives messages, the final flag of log #2 takes them\n"));
+}
+
+void Test::clean_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> source = config.add_object_statement("s_local");
+  add_object(config, *source, "internal", "source");
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_messages");
+  set_option(*add_object(config, *destination, "file", "destination"), "file", "/var/log/messages");
+
+  std::shared_ptr<LogStatement> log_statement = add_log(config, { source, destination }, "final");
+
+  QCOMPARE(lint_lines(config), std::string());
+}
+
+void Test::lint_benchmark()
+{
+  Config config;
+  std::vector< std::shared_ptr<ObjectStatement> > object_statements;
+  std::vector< std::shared_ptr<LogStatement> > log_statements;
+
+  for (int i = 0; i < n_log_statements; i++)
+  {
+    const std::string n = std::to_string(i);
+
+    std::shared_ptr<ObjectStatement> source = config.add_object_statement("s_" + n);
+    set_option(*add_object(config, *source, "network", "source"), "port", std::to_string(1024 + i));
+
+    std::shared_ptr<ObjectStatement> filter = config.add_object_statement("f_" + n);
+    std::shared_ptr<Object> host = add_object(config, *filter, "host", "filter");
+    set_option(*host, "host", "host" + n);
+    static_cast<Filter&>(*host).set_next("and");
+    set_option(*add_object(config, *filter, "level", "filter"), "level", "err");
+
+    std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_" + n);
+    set_option(*add_object(config, *destination, "file", "destination"), "file", "/var/log/" + n + "/messages");
+
+    log_statements.push_back(add_log(config, { source, filter, destination }, "final"));
+    object_statements.insert(object_statements.end(), { source, filter, destination });
+  }
+
+  QBENCHMARK
+  {
+    QVERIFY(lint(config).empty());
+  }
+}
+
+std::string Test::lint_lines(const Config& config)
+{
+  std::string lines;
+  for (const LintDiagnostic& diagnostic : lint(config))
+  {
+    lines += diagnostic.location + ": " + diagnostic.message + "\n";
+  }
+
+  return lines;
+}
+
+std::shared_ptr<Object> Test::add_object(Config& config, ObjectStatement& object_statement,
+                                        const std::string& name, const std::string& type)
+{
+  std::shared_ptr<Object> object = config.create_object(name, type);
+  object_statement.add_object(object, object_statement.get_objects().size());
+
+  return object;
+}
+
+std::shared_ptr<LogStatement> Test::add_log(Config& config, const std::vector< std::shared_ptr<ObjectStatement> >& object_statements,
+                                            const std::string& flags)
+{
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+
+  for (const std::shared_ptr<ObjectStatement>& object_statement : object_statements)
+  {
+    log_statement->add_object_statement(object_statement, log_statement->get_object_statements().size());
+  }
+
+  if (!flags.empty())
+  {
+    set_option(log_statement->get_options(), "flags", flags);
+  }
+
+  return log_statement;
+}
+
+QTEST_MAIN(Test)
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef LINT_H
+#define LINT_H
+
+#include <QObject>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Config;
+class Object;
+class ObjectStatement;
+class LogStatement;
+
+class Test : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void unused_test();
+  void empty_log_test();
+  void filter_test();
+  void duplicate_file_test();
+  void final_test();
+  void clean_test();
+  void lint_benchmark();
+
+private:
+  /*
+   * @return: returns the diagnostics of @config as "location: message" lines.
+   */
+  static std::string lint_lines(const Config& config);
+
+  /*
+   * @return: returns the Object @name of @type added to the end of @object_statement.
+   */
+  static std::shared_ptr<Object> add_object(Config& config, ObjectStatement& object_statement,
+                                            const std::string& name, const std::string& type);
+  static std::shared_ptr<LogStatement> add_log(Config& config, const std::vector< std::shared_ptr<ObjectStatement> >& object_statements,
+                                               const std::string& flags = std::string());
+};
+
+#endif  // LINT_H
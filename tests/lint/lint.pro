@@ -0,0 +1,14 @@
+TEMPLATE = app
+CONFIG += c++17 testcase
+TARGET = lint
+MOC_DIR = ../build/moc
+OBJECTS_DIR = ../build/obj
+QT = core testlib
+include(../../core/core.pri)
+
+INCLUDEPATH += ../common
+
+SOURCES += lint.cpp
+
+HEADERS += lint.h ../common/setoption.h
+
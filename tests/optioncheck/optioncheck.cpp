@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "optioncheck.h"
+#include "constraints.h"
+#include "config.h"
+#include "setoption.h"
+
+#include <QtTest/QTest>
+
+// the checked Objects of the benchmark, a network and a file destination in each statement
+static const int n_object_statements = 2500;
+
+void Test::initTestCase()
+{
+  config = std::make_unique<Config>();
+  config->parse_yaml("relations.yml");
+}
+
+void Test::cleanupTestCase()
+{
+  config.reset();
+}
+
+void Test::range_test()
+{
+  std::shared_ptr<Object> network = config->create_object("network", "destination");
+  set_option(*network, "network", "10.0.0.1");
+
+  set_option(*network, "port", "514");
+  QCOMPARE(check(*network), std::string());
+
+  set_option(*network, "port", "70000");
+  QCOMPARE(check(*network), std::string("70000 is out of range 0..65535"));
+}
+
+void Test::pattern_test()
+{
+  std::shared_ptr<Object> file = config->create_object("file", "destination");
+  set_option(*file, "file", "/var/log/messages");
+
+  set_option(*file, "perm", "0640");
+  QCOMPARE(check(*file), std::string());
+
+  set_option(*file, "perm", "0980");
+  QCOMPARE(check(*file), std::string("\"0980\" doesn't match 0?[0-7]{3}"));
+}
+
+void Test::path_test()
+{
+  std::shared_ptr<Object> file = config->create_object("file", "destination");
+
+  set_option(*file, "file", "/var/log/$HOST/messages");
+  QCOMPARE(check(*file), std::string());
+
+  set_option(*file, "file", "var/log/messages");
+  QCOMPARE(check(*file), std::string("\"var/log/messages\" is not an absolute file path"));
+
+  set_option(*file, "file", "/var/log/");
+  QCOMPARE(check(*file), std::string("\"/var/log/\" is not an absolute file path"));
+}
+
+void Test::required_test()
+{
+  std::shared_ptr<Object> file = config->create_object("file", "destination");
+  QCOMPARE(check(*file), std::string("is required"));
+}
+
+void Test::relations_test()
+{
+  std::shared_ptr<Object> relations = config->create_object("relations", "source");
+  QCOMPARE(check(*relations), std::string());
+
+  set_option(*relations, "ip", "0.0.0.0");
+  set_option(*relations, "unix", "/run/syslog");
+  QCOMPARE(check(*relations), std::string("can't be set together with unix"));
+
+  set_option(*relations, "unix", "");
+  set_option(*relations, "prefix", "^start");
+  QCOMPARE(check(*relations), std::string("requires mode to be set"));
+
+  set_option(*relations, "mode", "prefix");
+  QCOMPARE(check(*relations), std::string());
+}
+
+void Test::invalid_pattern_test()
+{
+  QVERIFY_EXCEPTION_THROWN(config->parse_yaml("broken.yml"), std::runtime_error);
+}
+
+void Test::config_test()
+{
+  Config config;
+
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement("d_network");
+  std::shared_ptr<Object> network = config.create_object("network", "destination");
+  set_option(*network, "network", "10.0.0.1");
+  set_option(*network, "ip-ttl", "300");
+  object_statement->add_object(network, 0);
+
+  std::shared_ptr<Object> file = config.create_object("file", "destination");
+  object_statement->add_object(file, 1);
+
+  const std::vector<ConstraintViolation> violations = check_constraints(config);
+
+  QCOMPARE(violations.size(), std::size_t(2));
+  QCOMPARE(violations[0].object, static_cast<const Object*>(network.get()));
+  QCOMPARE(violations[0].message, std::string("300 is out of range 0..255"));
+  QCOMPARE(violations[1].object, static_cast<const Object*>(file.get()));
+  QCOMPARE(violations[1].message, std::string("is required"));
+}
+
+void Test::check_benchmark()
+{
+  Config config;
+  std::vector< std::shared_ptr<ObjectStatement> > object_statements;
+
+  for (int i = 0; i < n_object_statements; i++)
+  {
+    const std::string n = std::to_string(i);
+
+    std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement("d_" + n);
+
+    std::shared_ptr<Object> network = config.create_object("network", "destination");
+    set_option(*network, "network", "10.0.0." + n);
+    set_option(*network, "port", "514");
+    object_statement->add_object(network, 0);
+
+    std::shared_ptr<Object> file = config.create_object("file", "destination");
+    set_option(*file, "file", "/var/log/" + n + "/messages");
+    set_option(*file, "perm", "0640");
+    object_statement->add_object(file, 1);
+
+    object_statements.push_back(object_statement);
+  }
+
+  QBENCHMARK
+  {
+    QVERIFY(check_constraints(config).empty());
+  }
+}
+
+std::string Test::check(const Object& object)
+{
+  std::vector<ConstraintViolation> violations;
+  check_constraints(object, violations);
+
+  std::string messages;
+  for (const ConstraintViolation& violation : violations)
+  {
+    messages += (messages.empty() ? "" : "\n") + violation.message;
+  }
+
+  return messages;
+}
+
+QTEST_MAIN(Test)
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef OPTIONCHECK_H
+#define OPTIONCHECK_H
+
+#include <QObject>
+
+#include <memory>
+#include <string>
+
+class Object;
+class Config;
+
+class Test : public QObject
+{
+  Q_OBJECT
+
+  std::unique_ptr<Config> config;
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void range_test();
+  void pattern_test();
+  void path_test();
+  void required_test();
+  void relations_test();
+  void invalid_pattern_test();
+  void config_test();
+  void check_benchmark();
+
+private:
+  /*
+   * @return: returns the messages of the violations of @object, separated by newlines.
+   */
+  static std::string check(const Object& object);
+};
+
+#endif  // OPTIONCHECK_H
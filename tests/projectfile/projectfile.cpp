@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "projectfile.h"
+#include "project.h"
+#include "config.h"
+#include "importer.h"
+#include "sink.h"
+#include "setoption.h"
+
+#include <QtTest/QTest>
+
+#include <stdexcept>
+
+// statements of 4 objects each, 10000 objects in the benchmark
+static const int n_object_statements = 2500;
+
+void Test::initTestCase()
+{
+  config = std::make_unique<Config>();
+}
+
+void Test::cleanupTestCase()
+{
+  config.reset();
+}
+
+void Test::round_trip_test()
+{
+  Importer importer(*config);
+  importer.import_file("../default/default.conf");
+
+  std::shared_ptr<Object> object = config->create_object("file", "destination");
+  set_option(*object, "file", "/var/log/unused");
+
+  ProjectWriter writer(*config);
+  writer.add_object_icon(*object, 10, 20);
+  writer.add_object_statement_icon(*importer.get_object_statements().front(), true, 30, 40);
+  writer.add_log_statement_icon(*importer.get_log_statements().back(), 50, 60);
+
+  {
+    StringSink sink(project);
+    writer.write(sink);
+  }
+
+  Config opened_config;
+  ProjectReader reader(opened_config);
+  reader.open_data(project);
+  reader.load_global_options();
+  reader.load_statements();
+
+  QCOMPARE(QString::fromStdString(opened_config.to_string()), QString::fromStdString(config->to_string()));
+  QVERIFY(reader.get_warnings().empty());
+
+  QCOMPARE(reader.get_icon_count(), std::size_t(3));
+
+  const ProjectIcon object_icon = reader.get_icon(0);
+  QCOMPARE(object_icon.kind, ProjectIcon::OBJECT);
+  QCOMPARE(object_icon.x, 10);
+  QCOMPARE(object_icon.y, 20);
+  QCOMPARE(reader.get_object(object_icon.index)->to_string(), object->to_string());
+
+  const ProjectIcon copy_icon = reader.get_icon(1);
+  QCOMPARE(copy_icon.kind, ProjectIcon::OBJECT_STATEMENT_COPY);
+  QCOMPARE(reader.get_object_statement(copy_icon.index)->get_id(), importer.get_object_statements().front()->get_id());
+
+  const ProjectIcon log_statement_icon = reader.get_icon(2);
+  QCOMPARE(log_statement_icon.kind, ProjectIcon::LOG_STATEMENT);
+  QCOMPARE(log_statement_icon.index, std::uint32_t(importer.get_log_statements().size() - 1));
+}
+
+void Test::damaged_project_test()
+{
+  Config opened_config;
+  ProjectReader reader(opened_config);
+
+  QVERIFY_EXCEPTION_THROWN(reader.open_data(project.substr(0, 20)), std::runtime_error);
+  QVERIFY_EXCEPTION_THROWN(reader.open_data(project.substr(0, project.size() - 1)), std::runtime_error);
+  QVERIFY_EXCEPTION_THROWN(reader.open_data("@version: 3.7\n"), std::runtime_error);
+
+  // a project of a newer version
+  std::string newer = project;
+  newer[8] = 2;
+  QVERIFY_EXCEPTION_THROWN(reader.open_data(newer), std::runtime_error);
+}
+
+void Test::staged_global_options_test()
+{
+  Config saved_config;
+  set_option(saved_config.get_global_options(), "time-reopen", "10");
+
+  std::string saved_project;
+  {
+    ProjectWriter writer(saved_config);
+    StringSink sink(saved_project);
+    writer.write(sink);
+  }
+
+  Config opened_config;
+  const std::uint64_t generation = opened_config.get_generation();
+  const std::string before = opened_config.to_string();
+  QVERIFY(before != saved_config.to_string());
+
+  Options global_options(opened_config.get_global_options());
+  ProjectReader reader(opened_config);
+  reader.open_data(saved_project);
+  reader.load_global_options(global_options);
+
+  // the copy has the saved values, the Config is unchanged until they are applied
+  QCOMPARE(global_options.to_string(), saved_config.get_global_options().to_string());
+  QCOMPARE(opened_config.get_generation(), generation);
+  QCOMPARE(opened_config.to_string(), before);
+
+  OptionVector& options = opened_config.get_global_options().get_options();
+  for (std::size_t i = 0; i < options.size(); i++)
+  {
+    options[i].set_values(global_options.get_options()[i]);
+  }
+
+  QVERIFY(opened_config.get_generation() != generation);
+  QCOMPARE(opened_config.to_string(), saved_config.to_string());
+}
+
+void Test::open_benchmark()
+{
+  Config large_config;
+  std::vector< std::shared_ptr<ObjectStatement> > object_statements;
+
+  for (int i = 0; i < n_object_statements; i++)
+  {
+    std::shared_ptr<ObjectStatement> object_statement = large_config.add_object_statement("d_" + std::to_string(i));
+
+    for (int j = 0; j < 4; j++)
+    {
+      std::shared_ptr<Object> object = large_config.create_object("file", "destination");
+      set_option(*object, "file", "/var/log/" + std::to_string(i) + "/" + std::to_string(j));
+
+      object_statement->add_object(object, j);
+    }
+
+    object_statements.push_back(object_statement);
+  }
+
+  std::string large_project;
+  {
+    ProjectWriter writer(large_config);
+    StringSink sink(large_project);
+    writer.write(sink);
+  }
+
+  QBENCHMARK
+  {
+    Config opened_config;
+    ProjectReader reader(opened_config);
+    reader.open_data(large_project);
+    reader.load_statements();
+
+    QCOMPARE(reader.get_object_count(), std::size_t(4 * n_object_statements));
+  }
+}
+
+QTEST_MAIN(Test)
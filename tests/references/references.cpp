@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "references.h"
+#include "config.h"
+
+#include <QtTest/QTest>
+
+#include <algorithm>
+
+// the LogStatements of the benchmark, all of them holding the same source
+static const int n_log_statements = 10000;
+
+void Test::log_statements_test()
+{
+  Config config;
+  const StatementIndex& index = config.get_index();
+
+  std::shared_ptr<ObjectStatement> source = config.add_object_statement("s_local");
+  std::shared_ptr<ObjectStatement> destination = config.add_object_statement("d_messages");
+  std::shared_ptr<LogStatement> first = config.add_log_statement();
+  std::shared_ptr<LogStatement> second = config.add_log_statement();
+
+  QCOMPARE(index.count_log_statements(*destination), std::size_t(0));
+
+  first->add_object_statement(source, 0);
+  first->add_object_statement(destination, 1);
+  second->add_object_statement(destination, 0);
+
+  QCOMPARE(index.count_log_statements(*source), std::size_t(1));
+  QCOMPARE(index.count_log_statements(*destination), std::size_t(2));
+
+  std::vector<const LogStatement*> log_statements = index.get_log_statements(*destination);
+  std::sort(log_statements.begin(), log_statements.end());
+  std::vector<const LogStatement*> expected = { first.get(), second.get() };
+  std::sort(expected.begin(), expected.end());
+  QCOMPARE(log_statements, expected);
+
+  first->remove_object_statement(destination);
+  QCOMPARE(index.get_log_statements(*destination), std::vector<const LogStatement*>({ second.get() }));
+
+  second->remove_object_statement(destination);
+  QCOMPARE(index.count_log_statements(*destination), std::size_t(0));
+  QCOMPARE(index.count_log_statements(*source), std::size_t(1));
+}
+
+void Test::objects_test()
+{
+  Config config;
+  const StatementIndex& index = config.get_index();
+
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement("d_messages");
+  std::shared_ptr<Object> file = config.create_object("file", "destination");
+  std::shared_ptr<Object> network = config.create_object("network", "destination");
+
+  object_statement->add_object(file, 0);
+  object_statement->add_object(network, 1);
+
+  QCOMPARE(index.get_object_statements(*file), std::vector<const ObjectStatement*>({ object_statement.get() }));
+  QCOMPARE(index.count_object_statements(*network), std::size_t(1));
+
+  object_statement->remove_object(file);
+  QCOMPARE(index.count_object_statements(*file), std::size_t(0));
+  QCOMPARE(index.count_object_statements(*network), std::size_t(1));
+}
+
+void Test::id_test()
+{
+  Config config;
+  const StatementIndex& index = config.get_index();
+
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement("f_auth");
+
+  QCOMPARE(index.find_object_statement("f_auth"), static_cast<const ObjectStatement*>(object_statement.get()));
+  QCOMPARE(index.find_object_statement("f_kern"), static_cast<const ObjectStatement*>(nullptr));
+
+  object_statement.reset();
+  QCOMPARE(index.find_object_statement("f_auth"), static_cast<const ObjectStatement*>(nullptr));
+}
+
+void Test::destruction_test()
+{
+  Config config;
+  const StatementIndex& index = config.get_index();
+
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement("d_messages");
+  std::shared_ptr<Object> file = config.create_object("file", "destination");
+  object_statement->add_object(file, 0);
+
+  std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+  log_statement->add_object_statement(object_statement, 0);
+
+  log_statement.reset();
+  QCOMPARE(index.count_log_statements(*object_statement), std::size_t(0));
+
+  object_statement.reset();
+  QCOMPARE(index.count_object_statements(*file), std::size_t(0));
+}
+
+void Test::count_benchmark()
+{
+  Config config;
+  const StatementIndex& index = config.get_index();
+
+  std::shared_ptr<ObjectStatement> source = config.add_object_statement("s_local");
+  std::vector< std::shared_ptr<LogStatement> > log_statements;
+
+  for (int i = 0; i < n_log_statements; i++)
+  {
+    std::shared_ptr<LogStatement> log_statement = config.add_log_statement();
+    log_statement->add_object_statement(source, 0);
+    log_statements.push_back(log_statement);
+  }
+
+  QBENCHMARK
+  {
+    QCOMPARE(index.count_log_statements(*source), std::size_t(n_log_statements));
+  }
+
+  // unlinking in the order of linking moves the last edge each time
+  for (const std::shared_ptr<LogStatement>& log_statement : log_statements)
+  {
+    log_statement->remove_object_statement(source);
+  }
+
+  QCOMPARE(index.count_log_statements(*source), std::size_t(0));
+}
+
+QTEST_MAIN(Test)
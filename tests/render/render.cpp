@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "render.h"
+#include "config.h"
+#include "sink.h"
+#include "setoption.h"
+
+#include <QBuffer>
+#include <QtTest/QTest>
+
+#include <sstream>
+#include <thread>
+
+// a generated configuration, large enough for the rendering to take a while
+static const int n_log_statements = 2000;
+
+void Test::initTestCase()
+{
+  config = std::make_unique<Config>();
+
+  for (int i = 0; i < n_log_statements; i++)
+  {
+    const std::string n = std::to_string(i);
+    std::shared_ptr<LogStatement> log_statement = config->add_log_statement();
+
+    const std::vector< std::pair<std::string, std::string> > members {
+      { "s_" + n, "source" }, { "f_" + n, "filter" }, { "d_" + n, "destination" }
+    };
+
+    for (const std::pair<std::string, std::string>& member : members)
+    {
+      std::shared_ptr<ObjectStatement> object_statement = config->add_object_statement(member.first);
+
+      const std::string name = member.second == "source" ? "syslog" : member.second == "filter" ? "match" : "file";
+      for (int j = 0; j < 4; j++)
+      {
+        std::shared_ptr<Object> object = config->create_object(name, member.second);
+
+        // the unnamed option, like the path of the file
+        set_option(*object, name, "/var/log/" + n + "/" + std::to_string(j));
+
+        object_statement->add_object(object, j);
+        objects.push_back(object);
+      }
+
+      log_statement->add_object_statement(object_statement, log_statement->get_object_statements().size());
+      object_statements.push_back(object_statement);
+    }
+
+    log_statements.push_back(log_statement);
+  }
+}
+
+void Test::cleanupTestCase()
+{
+  log_statements.clear();
+  object_statements.clear();
+  objects.clear();
+  config.reset();
+}
+
+void Test::sinks_test()
+{
+  const std::string expected = config->to_string();
+
+  // larger than the buffer of the BufferedSinks, so it's passed on in multiple pieces
+  QVERIFY(expected.size() > 64 * 1024);
+
+  std::string string;
+  {
+    StringSink sink(string);
+    config->write(sink);
+  }
+  QVERIFY(string == expected);
+
+  std::ostringstream stream;
+  {
+    StreamSink sink(stream);
+    config->write(sink);
+  }
+  QVERIFY(stream.str() == expected);
+
+  QBuffer buffer;
+  QVERIFY(buffer.open(QIODevice::WriteOnly));
+  {
+    DeviceSink sink(&buffer);
+    config->write(sink);
+    sink.flush();
+    QVERIFY(!sink.has_failed());
+  }
+  QVERIFY(buffer.data().toStdString() == expected);
+}
+
+void Test::shared_object_test()
+{
+  Config shared;
+
+  // one Object in every ObjectStatement, as a project file can hold it
+  std::shared_ptr<Object> object = shared.create_object("file", "destination");
+  std::vector< std::shared_ptr<ObjectStatement> > statements;
+  for (int i = 0; i < 100; i++)
+  {
+    statements.push_back(shared.add_object_statement("d_" + std::to_string(i)));
+    statements.back()->add_object(object, 0);
+  }
+
+  set_option(*object, "file", "/var/log/shared");
+
+  std::string parallel;
+  {
+    StringSink sink(parallel);
+    shared.write(sink, 4);
+  }
+
+  QVERIFY(parallel == shared.to_string());
+  QVERIFY(parallel.find("/var/log/shared", parallel.find("d_99")) != std::string::npos);
+}
+
+void Test::render_benchmark_data()
+{
+  QTest::addColumn<unsigned int>("n_threads");
+
+  QTest::newRow("1 thread") << 1u;
+  QTest::newRow("2 threads") << 2u;
+  QTest::newRow("4 threads") << 4u;
+  QTest::newRow("8 threads") << 8u;
+  QTest::newRow(qPrintable(QString("%1 threads, one per core").arg(std::thread::hardware_concurrency()))) << 0u;
+}
+
+void Test::render_benchmark()
+{
+  QFETCH(unsigned int, n_threads);
+
+  std::string serial;
+  {
+    StringSink sink(serial);
+    config->write(sink, 1);
+  }
+
+  // the same objects have to be formatted again, not just copied from their caches
+  for (const std::shared_ptr<Object>& object : objects)
+  {
+    object->get_generation().bump();
+  }
+
+  std::string parallel;
+  {
+    StringSink sink(parallel);
+    config->write(sink, n_threads);
+  }
+
+  QCOMPARE(parallel.size(), serial.size());
+  QVERIFY(parallel == serial);
+
+  QBENCHMARK
+  {
+    for (const std::shared_ptr<Object>& object : objects)
+    {
+      object->get_generation().bump();
+    }
+
+    std::string config_string;
+    StringSink sink(config_string);
+    config->write(sink, n_threads);
+  }
+}
+
+QTEST_MAIN(Test)
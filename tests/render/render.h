@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <QObject>
+
+#include <memory>
+#include <vector>
+
+class Object;
+class ObjectStatement;
+class LogStatement;
+class Config;
+
+class Test : public QObject
+{
+  Q_OBJECT
+
+  std::unique_ptr<Config> config;
+  std::vector< std::shared_ptr<Object> > objects;
+  std::vector< std::shared_ptr<ObjectStatement> > object_statements;
+  std::vector< std::shared_ptr<LogStatement> > log_statements;
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void sinks_test();
+  void shared_object_test();
+
+  void render_benchmark_data();
+  void render_benchmark();
+};
+
+#endif  // RENDER_H
@@ -20,6 +20,7 @@
 
 #include "sources.h"
 #include "config.h"
+#include "setoption.h"
 
 #include <QString>
 #include <QFile>
@@ -124,11 +125,10 @@ void Test::is_config_valid_test()
     set_option(options, "cert-file", "/opt/syslog-ng/etc/syslog-ng/keys/server_certificate.pem");
 
     auto it = std::find_if(syslog->get_options().begin(), syslog->get_options().end(),
-                           [](std::unique_ptr<Option>& option)->bool {
-                             return option->get_name() == "tls";
+                           [](Option& option)->bool {
+                             return option.get_name() == "tls";
                            });
-    ExternOption* tls = dynamic_cast<ExternOption*>(it->get());
-    tls->set_options(options);
+    it->set_options(options);
 
     s_syslog->add_object(syslog, 0);
   }
@@ -168,33 +168,14 @@ void Test::is_config_valid_test()
   QCOMPARE(QString::fromStdString(config.to_string()), conf);
 }
 
-void Test::set_option(Object& object, const std::string& option_name, const std::string& option_value)
-{
-  std::vector< std::unique_ptr<Option> >& options = object.get_options();
-  auto it = std::find_if(options.begin(), options.end(),
-                         [&option_name](std::unique_ptr<Option>& option)->bool {
-                           return option->get_name() == option_name;
-                         });
-
-  if (it != options.end())
-  {
-    std::unique_ptr<Option>& option = *it;
-    option->set_current(option_value);
-  }
-}
-
 std::shared_ptr<Object> Test::add_object(Config& config, const std::string& object_name, const std::string& object_type)
 {
-  const Object& default_object = config.get_default_object(object_name, object_type);
-  Object* object = default_object.clone();
-
-  return std::shared_ptr<Object>(object);
+  return config.create_object(object_name, object_type);
 }
 
 std::shared_ptr<ObjectStatement>& Test::add_object_statement(Config& config, const std::string& object_statement_id)
 {
-  ObjectStatement* new_object_statement = new ObjectStatement(object_statement_id);
-  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(new_object_statement);
+  std::shared_ptr<ObjectStatement> object_statement = config.add_object_statement(object_statement_id);
 
   object_statements.push_back(std::move(object_statement));
 
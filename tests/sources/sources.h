@@ -40,8 +40,6 @@ private slots:
   void is_config_valid_test();
 
 private:
-  void set_option(Object& object, const std::string& option_name, const std::string& option_value);
-
   std::shared_ptr<Object> add_object(Config& config, const std::string& object_name, const std::string& object_type);
   std::shared_ptr<ObjectStatement>& add_object_statement(Config& config, const std::string& object_statement_id);
 };
@@ -1,4 +1,4 @@
 TEMPLATE = subdirs
 
-SUBDIRS += default sources
+SUBDIRS += default sources clone render import projectfile validation optioncheck references lint cache builtin containers invalidation cli
 
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "validation.h"
+#include "validator.h"
+#include "batchvalidator.h"
+#include "config.h"
+#include "sink.h"
+#include "setoption.h"
+
+#include <QFile>
+#include <QtTest/QTest>
+
+#include <algorithm>
+#include <fstream>
+
+// the stub only looks at the file name in the configuration, see stub-syslog-ng
+static const int debounce = 100;
+
+void Test::initTestCase()
+{
+  config = std::make_unique<Config>();
+
+  object = config->create_object("file", "destination");
+  object_statement = config->add_object_statement("d_file");
+  object_statement->add_object(object, 0);
+
+  validator = std::make_unique<Validator>();
+  validator->set_program("sh", { "stub-syslog-ng", "-s", "-f" });
+  validator->set_debounce(debounce);
+
+  connect(validator.get(), &Validator::validated, [this](const ValidationResult& result) {
+    results.push_back(result);
+  });
+}
+
+void Test::cleanupTestCase()
+{
+  validator.reset();
+  object_statement.reset();
+  object.reset();
+  config.reset();
+}
+
+void Test::valid_test()
+{
+  set_option(*object, "file", "/var/log/messages");
+  validator->validate_now(*config);
+
+  QTRY_COMPARE_WITH_TIMEOUT(results.size(), std::size_t(1), 5000);
+  QVERIFY(results.back().status == ValidationStatus::VALID);
+  QVERIFY(!results.back().cached);
+  QCOMPARE(validator->get_statistics().runs, 1u);
+}
+
+void Test::cached_test()
+{
+  // the same configuration again, the result comes right away
+  validator->validate_now(*config);
+
+  QCOMPARE(results.size(), std::size_t(2));
+  QVERIFY(results.back().status == ValidationStatus::VALID);
+  QVERIFY(results.back().cached);
+  QCOMPARE(validator->get_statistics().runs, 1u);
+  QCOMPARE(validator->get_statistics().cache_hits, 1u);
+}
+
+void Test::invalid_test()
+{
+  set_option(*object, "file", "/var/log/invalid");
+  validator->validate_now(*config);
+
+  QTRY_COMPARE_WITH_TIMEOUT(results.size(), std::size_t(3), 5000);
+  QVERIFY(results.back().status == ValidationStatus::INVALID);
+  QVERIFY(results.back().message.find("syntax error") != std::string::npos);
+}
+
+void Test::debounce_test()
+{
+  const unsigned int runs = validator->get_statistics().runs;
+
+  for (int i = 0; i < 5; i++)
+  {
+    set_option(*object, "file", "/var/log/debounce/" + std::to_string(i));
+    validator->validate(*config);
+    QTest::qWait(debounce / 5);
+  }
+
+  QTRY_COMPARE_WITH_TIMEOUT(results.size(), std::size_t(4), 5000);
+  QTest::qWait(2 * debounce);
+
+  QCOMPARE(results.size(), std::size_t(4));
+  QCOMPARE(validator->get_statistics().runs, runs + 1);
+}
+
+void Test::cancel_test()
+{
+  set_option(*object, "file", "/var/log/slow");
+  validator->validate_now(*config);
+  QTest::qWait(debounce);
+
+  // the slow check is killed, only the result of the latest one comes
+  set_option(*object, "file", "/var/log/cancel");
+  validator->validate_now(*config);
+
+  QTRY_COMPARE_WITH_TIMEOUT(results.size(), std::size_t(5), 5000);
+  QVERIFY(results.back().status == ValidationStatus::VALID);
+  QTRY_COMPARE_WITH_TIMEOUT(validator->get_statistics().canceled, 1u, 5000);
+  QCOMPARE(results.size(), std::size_t(5));
+}
+
+void Test::timeout_test()
+{
+  validator->set_timeout(500);
+
+  set_option(*object, "file", "/var/log/slow/timeout");
+  validator->validate_now(*config);
+
+  QTRY_COMPARE_WITH_TIMEOUT(results.size(), std::size_t(6), 5000);
+  QVERIFY(results.back().status == ValidationStatus::TIMED_OUT);
+  QVERIFY(results.back().milliseconds >= 500);
+  QVERIFY(validator->get_statistics().max_milliseconds >= 500);
+}
+
+void Test::batch_test()
+{
+  // three different configurations, one of them invalid, each written twice
+  std::vector<std::string> file_names;
+  for (int i = 0; i < 6; i++)
+  {
+    file_names.push_back("batch-" + std::to_string(i) + ".conf");
+
+    std::ofstream file(file_names.back());
+    file << (i % 3 == 2 ? "invalid" : "config " + std::to_string(i % 3)) << std::endl;
+  }
+
+  BatchValidator batch_validator;
+  batch_validator.set_program("sh", { "stub-syslog-ng", "-s", "-f" });
+  batch_validator.set_processes(3);
+
+  std::string report;
+  StringSink sink(report);
+  const BatchValidator::Statistics statistics = batch_validator.run(file_names, sink);
+
+  for (const std::string& file_name : file_names)
+  {
+    QFile::remove(QString::fromStdString(file_name));
+  }
+
+  QCOMPARE(statistics.configs, std::size_t(6));
+  QCOMPARE(statistics.runs, std::size_t(3));
+  QCOMPARE(statistics.valid, std::size_t(4));
+  QCOMPARE(statistics.invalid, std::size_t(2));
+  QCOMPARE(statistics.failed, std::size_t(0));
+
+  QCOMPARE(std::count(report.begin(), report.end(), '\n'), 6L);
+
+  std::size_t duplicates = 0;
+  for (std::size_t i = report.find("\"duplicate_of\""); i != std::string::npos; i = report.find("\"duplicate_of\"", i + 1))
+  {
+    duplicates++;
+  }
+  QCOMPARE(duplicates, std::size_t(3));
+
+  QVERIFY(report.find("{\"file\":\"batch-2.conf\",\"status\":\"invalid\"") != std::string::npos ||
+          report.find("{\"file\":\"batch-5.conf\",\"status\":\"invalid\"") != std::string::npos);
+}
+
+QTEST_MAIN(Test)
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2015 Andras Mamenyak
+ *
+ * This file is part of syslog-ng-config-qt.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef VALIDATION_H
+#define VALIDATION_H
+
+#include "validator.h"
+
+#include <QObject>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Object;
+class ObjectStatement;
+class Config;
+
+class Test : public QObject
+{
+  Q_OBJECT
+
+  std::unique_ptr<Config> config;
+  std::shared_ptr<Object> object;
+  std::shared_ptr<ObjectStatement> object_statement;
+
+  std::unique_ptr<Validator> validator;
+  std::vector<ValidationResult> results;
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void valid_test();
+  void cached_test();
+  void invalid_test();
+  void debounce_test();
+  void cancel_test();
+  void timeout_test();
+  void batch_test();
+};
+
+#endif  // VALIDATION_H